@@ -34,205 +34,483 @@ private:
         return true;                              
     }
 
-public:
-    static void isNum(
-        const std::vector<str>& parameters,
-        const str& return_address,
-        SectionMemory& current_memory
-    )
-    {
-        if (parameters.size() != 1)
-            throw std::runtime_error("isNum() can only take 1 parameter!"); 
 
-        if (!current_memory.m_containsVariable(return_address))
-            throw std::runtime_error("Error! can't find the return address!"); 
+    typedef void (*utility_t)(const std::vector<str>&, const str&, SectionMemory&);
 
-        value_t value = { ___isNum___(parameters[0]), ENUM_TYPE_BOOL };
-        current_memory.m_reInsertVariable(return_address, value);      
+    struct Literal {};
+
+    // An operand as read from memory or from a literal: integers stay exact, everything else is real.
+    struct Number {
+        bool isInteger;
+        int64_t integer;
+        long double real;
+
+        template <typename D>
+        D as() const { return isInteger ? static_cast<D>(integer) : static_cast<D>(real); }
+    };
+
+    static void pm_throwTooSmall(const char* op) {
+        throw std::runtime_error(str("Return address too small for ") + op);
     }
-    static void sum(
-        const std::vector<str>& parameters,
-        const str& return_address,
-        SectionMemory& current_memory
-    )
-    {
-        if (!current_memory.m_containsVariable(return_address))
-            throw std::runtime_error("Error! can't find the return address!");
-        str current_str = "";             
-        long double accumulator = 0;      
-        for (auto item : parameters)
-        {
-            if (item.front() == '$')                             
-                current_str = current_memory.m_fetchStringalizedValue(item);
-            else
-                current_str = item;                             
-            if (!___isNum___(current_str))                      
-                throw std::runtime_error("Bad value for sum(): " + current_str);
-            accumulator += std::stold(current_str);             
+
+    static int64_t pm_checkedAdd(int64_t a, int64_t b, const char* op) {
+        int64_t result = 0;
+#if defined(__GNUC__) || defined(__clang__)
+        if (__builtin_add_overflow(a, b, &result))
+            pm_throwTooSmall(op);
+#else
+        if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b))
+            pm_throwTooSmall(op);
+        result = a + b;
+#endif
+        return result;
+    }
+
+    static int64_t pm_checkedSubtract(int64_t a, int64_t b, const char* op) {
+        int64_t result = 0;
+#if defined(__GNUC__) || defined(__clang__)
+        if (__builtin_sub_overflow(a, b, &result))
+            pm_throwTooSmall(op);
+#else
+        if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b))
+            pm_throwTooSmall(op);
+        result = a - b;
+#endif
+        return result;
+    }
+
+    static int64_t pm_checkedMultiply(int64_t a, int64_t b, const char* op) {
+        int64_t result = 0;
+#if defined(__GNUC__) || defined(__clang__)
+        if (__builtin_mul_overflow(a, b, &result))
+            pm_throwTooSmall(op);
+#else
+        if (a > 0 ? (b > 0 ? a > INT64_MAX / b : b < INT64_MIN / a)
+                  : (b > 0 ? a < INT64_MIN / b : (a != 0 && b < INT64_MAX / a)))
+            pm_throwTooSmall(op);
+        result = a * b;
+#endif
+        return result;
+    }
+
+    // Each operation works in the domain picked for it: int64_t when every operand is an integer
+    // and the result is, double for f32/f64, and long double only for fmax.
+    struct AddOp {
+        static constexpr const char* name = "sum";
+        static constexpr int identity = 0;
+        template <typename D>
+        static D apply(D a, D b) {
+            if constexpr (std::is_integral_v<D>) return pm_checkedAdd(a, b, name);
+            else return a + b;
+        }
+        static void generic(const std::vector<str>& p, const str& r, SectionMemory& m) { ArithmeticEngine::sum(p, r, m); }
+    };
+    struct SubtractOp {
+        static constexpr const char* name = "subtract";
+        template <typename D>
+        static D apply(D a, D b) {
+            if constexpr (std::is_integral_v<D>) return pm_checkedSubtract(a, b, name);
+            else return a - b;
+        }
+        static void generic(const std::vector<str>& p, const str& r, SectionMemory& m) { ArithmeticEngine::subtract(p, r, m); }
+    };
+    struct MultiplyOp {
+        static constexpr const char* name = "product";
+        static constexpr int identity = 1;
+        template <typename D>
+        static D apply(D a, D b) {
+            if constexpr (std::is_integral_v<D>) return pm_checkedMultiply(a, b, name);
+            else return a * b;
+        }
+        static void generic(const std::vector<str>& p, const str& r, SectionMemory& m) { ArithmeticEngine::product(p, r, m); }
+    };
+    struct DivideOp {
+        static constexpr const char* name = "divide";
+        template <typename D>
+        static D apply(D a, D b) {
+            if constexpr (std::is_integral_v<D>) {
+                if (b == 0)
+                    throw std::runtime_error("Division by zero in divide()!");
+                if (a == INT64_MIN && b == -1)
+                    pm_throwTooSmall(name);
+                return a / b;
+            }
+            else return a / b;
+        }
+        static void generic(const std::vector<str>& p, const str& r, SectionMemory& m) { ArithmeticEngine::divide(p, r, m); }
+    };
+    struct ModOp {
+        static constexpr const char* name = "mod";
+        template <typename D>
+        static D apply(D a, D b) {
+            int64_t divisor = static_cast<int64_t>(b);
+            if (divisor == 0)
+                throw std::runtime_error("Division by zero in mod()!");
+            if (divisor == -1)
+                return 0;
+            return static_cast<D>(static_cast<int64_t>(a) % divisor);
+        }
+        static void generic(const std::vector<str>& p, const str& r, SectionMemory& m) { ArithmeticEngine::mod(p, r, m); }
+    };
+    struct PowOp {
+        static constexpr const char* name = "pow";
+        template <typename D>
+        static D apply(D a, D b) {
+            if constexpr (std::is_integral_v<D>) {
+                if (b < 0) {
+                    if (a == 0)
+                        throw std::runtime_error("Division by zero in pow()!");
+                    return (a == 1 || a == -1) ? ((b % 2 == 0) ? 1 : a) : 0;
+                }
+                int64_t result = 1;
+                while (b > 0) {
+                    if (b & 1)
+                        result = pm_checkedMultiply(result, a, name);
+                    b >>= 1;
+                    if (b > 0)
+                        a = pm_checkedMultiply(a, a, name);
+                }
+                return result;
+            }
+            else return std::pow(a, b);
+        }
+        static void generic(const std::vector<str>& p, const str& r, SectionMemory& m) { ArithmeticEngine::pow(p, r, m); }
+    };
+    struct FloorOp {
+        static constexpr const char* name = "floor";
+        template <typename D>
+        static D apply(D a) {
+            if constexpr (std::is_integral_v<D>) return a;
+            else return std::floor(a);
+        }
+        static void generic(const std::vector<str>& p, const str& r, SectionMemory& m) { ArithmeticEngine::floor(p, r, m); }
+    };
+    struct CeilingOp {
+        static constexpr const char* name = "ceiling";
+        template <typename D>
+        static D apply(D a) {
+            if constexpr (std::is_integral_v<D>) return a;
+            else return std::ceil(a);
+        }
+        static void generic(const std::vector<str>& p, const str& r, SectionMemory& m) { ArithmeticEngine::ceiling(p, r, m); }
+    };
+    struct AbsOp {
+        static constexpr const char* name = "abs";
+        template <typename D>
+        static D apply(D a) {
+            if constexpr (std::is_integral_v<D>) return a < 0 ? pm_checkedSubtract(0, a, name) : a;
+            else return std::abs(a);
+        }
+        static void generic(const std::vector<str>& p, const str& r, SectionMemory& m) { ArithmeticEngine::abs(p, r, m); }
+    };
+
+    template <typename T>
+    using pm_domain_t = std::conditional_t<std::is_integral_v<T>, int64_t,
+        std::conditional_t<std::is_same_v<T, long double>, long double, double>>;
+
+    template <typename Out, typename D>
+    static Out pm_narrow(D value, const char* op) {
+        if constexpr (std::is_integral_v<Out> && std::is_integral_v<D>) {
+            if constexpr (sizeof(Out) < sizeof(D)) {
+                if (value < std::numeric_limits<Out>::lowest() || value > std::numeric_limits<Out>::max())
+                    pm_throwTooSmall(op);
+            }
         }
-        auto ra = current_memory.m_getVariable(return_address); 
-        switch (ra.second)
-        {
-        case ENUM_TYPE_I8:
-        {
-            if (accumulator < -128 || accumulator > 127)
-                throw std::runtime_error("Return address too small for sum");
+        else if constexpr (std::is_integral_v<Out>) {
+            // -lowest() is a power of two, so it is exact in D even for int64_t.
+            if (!(value >= static_cast<D>(std::numeric_limits<Out>::lowest()) &&
+                value < -static_cast<D>(std::numeric_limits<Out>::lowest())))
+                pm_throwTooSmall(op);
+        }
+        else if constexpr (!std::is_same_v<Out, long double> && !std::is_integral_v<D>) {
+            if (value < -static_cast<D>(std::numeric_limits<Out>::max()) ||
+                value > static_cast<D>(std::numeric_limits<Out>::max()))
+                pm_throwTooSmall(op);
+        }
+        return static_cast<Out>(value);
+    }
 
-            int8_t val = static_cast<int8_t>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I8 });
-            break;
+    static Number pm_readNumber(const str& item, SectionMemory& current_memory, const char* op) {
+        str current_str = item;
+        if (item.front() == '$') {
+            str var_name = item.substr(1);
+            if (current_memory.m_containsVariable(var_name)) {
+                switch (current_memory.m_getType(var_name)) {
+                case ENUM_TYPE_I8: return { true, *current_memory.m_findTyped<int8_t>(var_name), 0 };
+                case ENUM_TYPE_I16: return { true, *current_memory.m_findTyped<int16_t>(var_name), 0 };
+                case ENUM_TYPE_I32: return { true, *current_memory.m_findTyped<int32_t>(var_name), 0 };
+                case ENUM_TYPE_I64: return { true, *current_memory.m_findTyped<int64_t>(var_name), 0 };
+                case ENUM_TYPE_F32: return { false, 0, *current_memory.m_findTyped<float>(var_name) };
+                case ENUM_TYPE_F64: return { false, 0, *current_memory.m_findTyped<double>(var_name) };
+                case ENUM_TYPE_FMAX: return { false, 0, *current_memory.m_findTyped<long double>(var_name) };
+                default: break;
+                }
+            }
+            current_str = current_memory.m_fetchStringalizedValue(current_str);
         }
 
-        case ENUM_TYPE_I16:
-        {
-            if (accumulator < -32768 || accumulator > 32767)
-                throw std::runtime_error("Return address too small for sum");
+        if (!___isNum___(current_str))
+            throw std::runtime_error(str("Bad value for ") + op + "(): " + current_str);
+        int64_t integer = 0;
+        if (current_str.find('.') == str::npos && NumberConversion::tryParse(current_str, integer) == std::errc())
+            return { true, integer, 0 };
+        return { false, 0, NumberConversion::parse<long double>(current_str) };
+    }
 
-            int16_t val = static_cast<int16_t>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I16 });
-            break;
+    template <typename Op, typename D>
+    static D pm_fold(const std::vector<Number>& values) {
+        if constexpr (requires { Op::identity; }) {
+            if (values.empty())
+                return static_cast<D>(Op::identity);
         }
+        if constexpr (requires { Op::template apply<D>(D{}); }) {
+            return Op::template apply<D>(values[0].as<D>());
+        }
+        else {
+            D result = values[0].as<D>();
+            for (size_t idx = 1; idx < values.size(); ++idx)
+                result = Op::template apply<D>(result, values[idx].as<D>());
+            return result;
+        }
+    }
 
-        case ENUM_TYPE_I32:
-        {
-            if (accumulator < INT32_MIN || accumulator > INT32_MAX)
-                throw std::runtime_error("Return address too small for sum");
-
-            int32_t val = static_cast<int32_t>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I32 });
-            break;
+    template <typename D>
+    static void pm_store(SectionMemory& current_memory, const str& return_address, typeEnum type, D value, const char* op) {
+        switch (type)
+        {
+        case ENUM_TYPE_I8: current_memory.m_reInsertVariable(return_address, { pm_narrow<int8_t>(value, op), ENUM_TYPE_I8 }); break;
+        case ENUM_TYPE_I16: current_memory.m_reInsertVariable(return_address, { pm_narrow<int16_t>(value, op), ENUM_TYPE_I16 }); break;
+        case ENUM_TYPE_I32: current_memory.m_reInsertVariable(return_address, { pm_narrow<int32_t>(value, op), ENUM_TYPE_I32 }); break;
+        case ENUM_TYPE_I64: current_memory.m_reInsertVariable(return_address, { pm_narrow<int64_t>(value, op), ENUM_TYPE_I64 }); break;
+        case ENUM_TYPE_F32: current_memory.m_reInsertVariable(return_address, { pm_narrow<float>(value, op), ENUM_TYPE_F32 }); break;
+        case ENUM_TYPE_F64: current_memory.m_reInsertVariable(return_address, { pm_narrow<double>(value, op), ENUM_TYPE_F64 }); break;
+        case ENUM_TYPE_FMAX: current_memory.m_reInsertVariable(return_address, { pm_narrow<long double>(value, op), ENUM_TYPE_FMAX }); break;
+        default:
+            throw std::runtime_error(str("Invalid type for ") + op + "(): only numeric types allowed");
         }
+    }
 
-        case ENUM_TYPE_I64:
-        {
-            int64_t val = static_cast<int64_t>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I64 });
-            break;
+    // Shared body of the generic functions: reads every operand natively, then folds them in the
+    // domain chosen by the return address type.
+    template <typename Op>
+    static void pm_evaluate(const std::vector<str>& parameters, const str& return_address, SectionMemory& current_memory) {
+        std::vector<Number> values;
+        values.reserve(parameters.size());
+        bool allIntegers = true;
+        for (auto& item : parameters) {
+            values.push_back(pm_readNumber(item, current_memory, Op::name));
+            allIntegers = allIntegers && values.back().isInteger;
         }
 
-        case ENUM_TYPE_F32:
+        typeEnum type = current_memory.m_getType(return_address);
+        switch (type)
         {
-            if (accumulator < -FLT_MAX || accumulator > FLT_MAX)
-                throw std::runtime_error("Return address too small for sum");
-
-            float val = static_cast<float>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F32 });
+        case ENUM_TYPE_I8:
+        case ENUM_TYPE_I16:
+        case ENUM_TYPE_I32:
+        case ENUM_TYPE_I64:
+            if (allIntegers)
+                pm_store(current_memory, return_address, type, pm_fold<Op, int64_t>(values), Op::name);
+            else
+                pm_store(current_memory, return_address, type, pm_fold<Op, double>(values), Op::name);
             break;
-        }
-
+        case ENUM_TYPE_F32:
         case ENUM_TYPE_F64:
-        {
-            if (accumulator < -DBL_MAX || accumulator > DBL_MAX)
-                throw std::runtime_error("Return address too small for sum");
-
-            double val = static_cast<double>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F64 });
+            pm_store(current_memory, return_address, type, pm_fold<Op, double>(values), Op::name);
             break;
-        }
-
         case ENUM_TYPE_FMAX:
-        {
-            // highest precision: reinsert as long double
-            current_memory.m_reInsertVariable(return_address, { accumulator, ENUM_TYPE_FMAX });
+            pm_store(current_memory, return_address, type, pm_fold<Op, long double>(values), Op::name);
             break;
+        default:
+            throw std::runtime_error(str("Invalid type for ") + Op::name + "(): only numeric types allowed");
         }
+    }
 
-        default:
-            throw std::runtime_error("Invalid type for sum(): only numeric types allowed");
+    template <typename T, typename D>
+    static bool pm_readOperand(const str& token, SectionMemory& current_memory, D& out) {
+        if constexpr (std::is_same_v<T, Literal>) {
+            out = NumberConversion::parse<D>(token);
+            return true;
+        }
+        else {
+            T* slot = current_memory.m_findTyped<T>(token);
+            if (!slot) return false;
+            out = static_cast<D>(*slot);
+            return true;
         }
     }
-    static void product(
+
+    static void pm_fallback(
+        utility_t generic,
         const std::vector<str>& parameters,
+        bool firstIsVariable,
+        bool secondIsVariable,
         const str& return_address,
         SectionMemory& current_memory
     )
     {
-        if (!current_memory.m_containsVariable(return_address))
-            throw std::runtime_error("Error! can't find the return address!");
+        std::vector<str> generic_parameters = parameters;
+        if (generic_parameters.size() > 0 && firstIsVariable)
+            generic_parameters[0] = str("$") + generic_parameters[0];
+        if (generic_parameters.size() > 1 && secondIsVariable)
+            generic_parameters[1] = str("$") + generic_parameters[1];
+        generic(generic_parameters, return_address, current_memory);
+    }
 
-        str current_str = "";
-        long double accumulator = 1.0L; 
-        for (auto item : parameters)
+    // Opcodes emitted by the compiler's type specialization pass. Variable operands arrive as bare
+    // names, their types are encoded in the opcode, and a type mismatch falls back to the generic function.
+    template <typename Op, typename L, typename R, typename Out>
+    static void pm_specializedBinary(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    )
+    {
+        pm_domain_t<Out> left = 0, right = 0;
+        Out* target = current_memory.m_findTyped<Out>(return_address);
+        if (parameters.size() != 2 || !target ||
+            !pm_readOperand<L>(parameters[0], current_memory, left) ||
+            !pm_readOperand<R>(parameters[1], current_memory, right))
         {
-            if (item.front() == '$')
-                current_str = current_memory.m_fetchStringalizedValue(item);
-            else
-                current_str = item;
-
-            if (!___isNum___(current_str))
-                throw std::runtime_error("Bad value for sum(): " + current_str); 
-
-            accumulator *= std::stold(current_str);
+            pm_fallback(&Op::generic, parameters,
+                !std::is_same_v<L, Literal>, !std::is_same_v<R, Literal>, return_address, current_memory);
+            return;
         }
-        auto ra = current_memory.m_getVariable(return_address);
-        switch (ra.second)
-        {
-        case ENUM_TYPE_I8:
-        {
-            if (accumulator < -128 || accumulator > 127)
-                throw std::runtime_error("Return address too small for product");
+        *target = pm_narrow<Out>(Op::apply(left, right), Op::name);
+    }
 
-            int8_t val = static_cast<int8_t>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I8 });
-            break;
+    template <typename Op, typename T, typename Out>
+    static void pm_specializedUnary(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    )
+    {
+        pm_domain_t<Out> value = 0;
+        Out* target = current_memory.m_findTyped<Out>(return_address);
+        if (parameters.size() != 1 || !target || !pm_readOperand<T>(parameters[0], current_memory, value))
+        {
+            pm_fallback(&Op::generic, parameters, !std::is_same_v<T, Literal>, false, return_address, current_memory);
+            return;
         }
+        *target = pm_narrow<Out>(Op::apply(value), Op::name);
+    }
 
-        case ENUM_TYPE_I16:
-        {
-            if (accumulator < -32768 || accumulator > 32767)
-                throw std::runtime_error("Return address too small for product");
+    typedef std::tuple<int8_t, int16_t, int32_t, int64_t, float, double, long double> result_types_t;
 
-            int16_t val = static_cast<int16_t>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I16 });
-            break;
-        }
+    static int pm_typeIndex(const str& name) {
+        static const char* names[] = { "i8", "i16", "i32", "i64", "f32", "f64", "fmax" };
+        for (int idx = 0; idx < 7; ++idx)
+            if (name == names[idx])
+                return idx;
+        return -1;
+    }
 
-        case ENUM_TYPE_I32:
-        {
-            if (accumulator < INT32_MIN || accumulator > INT32_MAX)
-                throw std::runtime_error("Return address too small for product");
+    template <typename Op, typename T>
+    static utility_t pm_binaryKernel(bool leftIsVariable, bool rightIsVariable) {
+        if (leftIsVariable && rightIsVariable) return &pm_specializedBinary<Op, T, T, T>;
+        if (leftIsVariable) return &pm_specializedBinary<Op, T, Literal, T>;
+        return &pm_specializedBinary<Op, Literal, T, T>;
+    }
 
-            int32_t val = static_cast<int32_t>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I32 });
-            break;
-        }
+    template <typename Op, size_t... T>
+    static utility_t pm_binaryLookup(int type, bool leftIsVariable, bool rightIsVariable, std::index_sequence<T...>) {
+        utility_t result = nullptr;
+        ((T == static_cast<size_t>(type) ?
+            (result = pm_binaryKernel<Op, std::tuple_element_t<T, result_types_t>>(leftIsVariable, rightIsVariable)) : nullptr), ...);
+        return result;
+    }
 
-        case ENUM_TYPE_I64:
-        {
-            int64_t val = static_cast<int64_t>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I64 });
-            break;
-        }
+    template <typename Op, size_t... T>
+    static utility_t pm_unaryLookup(int type, std::index_sequence<T...>) {
+        utility_t result = nullptr;
+        ((T == static_cast<size_t>(type) ?
+            (result = &pm_specializedUnary<Op, std::tuple_element_t<T, result_types_t>, std::tuple_element_t<T, result_types_t>>) : nullptr), ...);
+        return result;
+    }
 
-        case ENUM_TYPE_F32:
-        {
-            if (accumulator < -FLT_MAX || accumulator > FLT_MAX)
-                throw std::runtime_error("Return address too small for product");
+public:
+    // Resolves an opcode such as add_i64_c_to_i64 to its kernel, or nullptr if it isn't one.
+    // Only operands of the result type (or literals, written as c) have kernels.
+    static utility_t specializedUtility(const str& opcode) {
+        size_t to = opcode.rfind("_to_");
+        if (to == str::npos)
+            return nullptr;
+        int type = pm_typeIndex(opcode.substr(to + 4));
+        if (type < 0)
+            return nullptr;
+
+        std::vector<str> parts;
+        size_t begin = 0;
+        while (begin <= to) {
+            size_t next = opcode.find('_', begin);
+            if (next == str::npos || next > to) next = to;
+            parts.push_back(opcode.substr(begin, next - begin));
+            begin = next + 1;
+        }
+
+        std::vector<bool> isVariable;
+        for (size_t idx = 1; idx < parts.size(); ++idx) {
+            if (parts[idx] != "c" && pm_typeIndex(parts[idx]) != type)
+                return nullptr;
+            isVariable.push_back(parts[idx] != "c");
+        }
+
+        const str& op = parts[0];
+        auto types = std::make_index_sequence<7>{};
+        if (isVariable.size() == 2 && (isVariable[0] || isVariable[1])) {
+            if (op == "add") return pm_binaryLookup<AddOp>(type, isVariable[0], isVariable[1], types);
+            if (op == "subtract") return pm_binaryLookup<SubtractOp>(type, isVariable[0], isVariable[1], types);
+            if (op == "multiply") return pm_binaryLookup<MultiplyOp>(type, isVariable[0], isVariable[1], types);
+            if (op == "divide") return pm_binaryLookup<DivideOp>(type, isVariable[0], isVariable[1], types);
+            if (op == "mod") return pm_binaryLookup<ModOp>(type, isVariable[0], isVariable[1], types);
+            if (op == "pow") return pm_binaryLookup<PowOp>(type, isVariable[0], isVariable[1], types);
+        }
+        if (isVariable.size() == 1 && isVariable[0]) {
+            if (op == "floor") return pm_unaryLookup<FloorOp>(type, types);
+            if (op == "ceiling") return pm_unaryLookup<CeilingOp>(type, types);
+            if (op == "abs") return pm_unaryLookup<AbsOp>(type, types);
+        }
+        return nullptr;
+    }
 
-            float val = static_cast<float>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F32 });
-            break;
-        }
+    static void isNum(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    )
+    {
+        if (parameters.size() != 1)
+            throw std::runtime_error("isNum() can only take 1 parameter!"); 
 
-        case ENUM_TYPE_F64:
-        {
-            if (accumulator < -DBL_MAX || accumulator > DBL_MAX)
-                throw std::runtime_error("Return address too small for product");
+        if (!current_memory.m_containsVariable(return_address))
+            throw std::runtime_error("Error! can't find the return address!"); 
 
-            double val = static_cast<double>(accumulator);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F64 });
-            break;
-        }
+        value_t value = { ___isNum___(parameters[0]), ENUM_TYPE_BOOL };
+        current_memory.m_reInsertVariable(return_address, value);      
+    }
 
-        case ENUM_TYPE_FMAX:
-        {
-            current_memory.m_reInsertVariable(return_address, { accumulator, ENUM_TYPE_FMAX });
-            break;
-        }
+    static void sum(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    )
+    {
+        if (!current_memory.m_containsVariable(return_address))
+            throw std::runtime_error("Error! can't find the return address!");
 
-        default:
-            throw std::runtime_error("Invalid type for product(): only numeric types allowed");
-        }
+        pm_evaluate<AddOp>(parameters, return_address, current_memory);
+    }
+    static void product(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    )
+    {
+        if (!current_memory.m_containsVariable(return_address))
+            throw std::runtime_error("Error! can't find the return address!");
+
+        pm_evaluate<MultiplyOp>(parameters, return_address, current_memory);
     }
     static void subtract(
         const std::vector<str>& parameters,
@@ -246,91 +524,7 @@ public:
         if (parameters.size() != 2)
             throw std::runtime_error("Error! subtract() only takes two parameters!");
 
-        str val_1 = parameters[0];
-        str val_2 = parameters[1]; 
-
-        if (val_1.front() == '$')
-            val_1 = current_memory.m_fetchStringalizedValue(val_1); 
-
-        if (val_2.front() == '$')
-            val_2 = current_memory.m_fetchStringalizedValue(val_2);
-
-        if (!___isNum___(val_1))
-            throw std::runtime_error(str("Bad values for function subtract(): ") + val_1);
-
-        if (!___isNum___(val_2))
-            throw std::runtime_error(str("Bad values for function subtract(): ") + val_2);
-
-        long double result = std::stold(val_1) - std::stold(val_2); 
-        auto ra = current_memory.m_getVariable(return_address);   
-        switch (ra.second)
-        {
-        case ENUM_TYPE_I8:
-        {
-            if (result < -128 || result > 127)
-                throw std::runtime_error("Return address too small for subtract!");
-
-            int8_t val = static_cast<int8_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I8 });
-            break;
-        }
-
-        case ENUM_TYPE_I16:
-        {
-            if (result < -32768 || result > 32767)
-                throw std::runtime_error("Return address too small for subtract!");
-
-            int16_t val = static_cast<int16_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I16 });
-            break;
-        }
-
-        case ENUM_TYPE_I32:
-        {
-            if (result < INT32_MIN || result > INT32_MAX)
-                throw std::runtime_error("Return address too small for subtract!");
-
-            int32_t val = static_cast<int32_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I32 });
-            break;
-        }
-
-        case ENUM_TYPE_I64:
-        {
-            int64_t val = static_cast<int64_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I64 });
-            break;
-        }
-
-        case ENUM_TYPE_F32:
-        {
-            if (result < -FLT_MAX || result > FLT_MAX)
-                throw std::runtime_error("Return address too small for subtract!");
-
-            float val = static_cast<float>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F32 });
-            break;
-        }
-
-        case ENUM_TYPE_F64:
-        {
-            if (result < -DBL_MAX || result > DBL_MAX)
-                throw std::runtime_error("Return address too small for sum");
-
-            double val = static_cast<double>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F64 });
-            break;
-        }
-
-        case ENUM_TYPE_FMAX:
-        {
-            current_memory.m_reInsertVariable(return_address, { result, ENUM_TYPE_FMAX });
-            break;
-        }
-
-        default:
-            throw std::runtime_error("Invalid type for subtract(): only numeric types allowed");
-        }
+        pm_evaluate<SubtractOp>(parameters, return_address, current_memory);
     }
     static void divide(
         const std::vector<str>& parameters,
@@ -344,90 +538,7 @@ public:
         if (parameters.size() != 2)
             throw std::runtime_error("Error! divide() only takes two parameters!");
 
-        str val_1 = parameters[0];
-        str val_2 = parameters[1];
-
-        if (val_1.front() == '$')
-            val_1 = current_memory.m_fetchStringalizedValue(val_1);
-
-        if (val_2.front() == '$')
-            val_2 = current_memory.m_fetchStringalizedValue(val_2);
-
-        if (!___isNum___(val_1))
-            throw std::runtime_error(str("Bad values for function divide(): ") + val_1);
-
-        if (!___isNum___(val_2))
-            throw std::runtime_error(str("Bad values for function divide(): ") + val_2);
-
-        long double result = std::stold(val_1) / std::stold(val_2); 
-        auto ra = current_memory.m_getVariable(return_address);
-        switch (ra.second)
-        {
-        case ENUM_TYPE_I8:
-        {
-            if (result < -128 || result > 127)
-                throw std::runtime_error("Return address too small for divide");
-
-            int8_t val = static_cast<int8_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I8 });
-            break;
-        }
-
-        case ENUM_TYPE_I16:
-        {
-            if (result < -32768 || result > 32767)
-                throw std::runtime_error("Return address too small for divide");
-
-            int16_t val = static_cast<int16_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I16 });
-            break;
-        }
-
-        case ENUM_TYPE_I32:
-        {
-            if (result < INT32_MIN || result > INT32_MAX)
-                throw std::runtime_error("Return address too small for divide");
-
-            int32_t val = static_cast<int32_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I32 });
-            break;
-        }
-
-        case ENUM_TYPE_I64:
-        {
-            int64_t val = static_cast<int64_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I64 });
-            break;
-        }
-
-        case ENUM_TYPE_F32:
-        {
-            if (result < -FLT_MAX || result > FLT_MAX)
-                throw std::runtime_error("Return address too small for divide");
-
-            float val = static_cast<float>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F32 });
-            break;
-        }
-
-        case ENUM_TYPE_F64:
-        {
-            if (result < -DBL_MAX || result > DBL_MAX)
-                throw std::runtime_error("Return address too small for divide");
-            double val = static_cast<double>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F64 });
-            break;
-        }
-
-        case ENUM_TYPE_FMAX:
-        {
-            current_memory.m_reInsertVariable(return_address, { result, ENUM_TYPE_FMAX });
-            break;
-        }
-
-        default:
-            throw std::runtime_error("Invalid type for divide(): only numeric types allowed");
-        }
+        pm_evaluate<DivideOp>(parameters, return_address, current_memory);
     }
     static void mod(
         const std::vector<str>& parameters,
@@ -441,94 +552,7 @@ public:
         if (parameters.size() != 2)
             throw std::runtime_error("Error! mod() only takes two parameters!");
 
-        str val_1 = parameters[0];
-        str val_2 = parameters[1];
-
-        if (val_1.front() == '$')
-            val_1 = current_memory.m_fetchStringalizedValue(val_1);
-
-        if (val_2.front() == '$')
-            val_2 = current_memory.m_fetchStringalizedValue(val_2);
-
-        if (!___isNum___(val_1))
-            throw std::runtime_error(str("Bad values for function mod(): ") + val_1);
-
-        if (!___isNum___(val_2))
-            throw std::runtime_error(str("Bad values for function mod(): ") + val_2);
-
-        long long result =
-            (long long)std::stold(val_1) %
-            (long long)std::stold(val_2); 
-
-        auto ra = current_memory.m_getVariable(return_address);
-        switch (ra.second)
-        {
-        case ENUM_TYPE_I8:
-        {
-            if (result < -128 || result > 127)
-                throw std::runtime_error("Return address too small for mod");
-
-            int8_t val = static_cast<int8_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I8 });
-            break;
-        }
-
-        case ENUM_TYPE_I16:
-        {
-            if (result < -32768 || result > 32767)
-                throw std::runtime_error("Return address too small for mod");
-
-            int16_t val = static_cast<int16_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I16 });
-            break;
-        }
-
-        case ENUM_TYPE_I32:
-        {
-            if (result < INT32_MIN || result > INT32_MAX)
-                throw std::runtime_error("Return address too small for mod");
-
-            int32_t val = static_cast<int32_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I32 });
-            break;
-        }
-
-        case ENUM_TYPE_I64:
-        {
-            int64_t val = static_cast<int64_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I64 });
-            break;
-        }
-
-        case ENUM_TYPE_F32:
-        {
-            if (result < -FLT_MAX || result > FLT_MAX)
-                throw std::runtime_error("Return address too small for mod");
-
-            float val = static_cast<float>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F32 });
-            break;
-        }
-
-        case ENUM_TYPE_F64:
-        {
-            if (result < -DBL_MAX || result > DBL_MAX)
-                throw std::runtime_error("Return address too small for mod");
-
-            double val = static_cast<double>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F64 });
-            break;
-        }
-
-        case ENUM_TYPE_FMAX:
-        {
-            current_memory.m_reInsertVariable(return_address, { result, ENUM_TYPE_FMAX });
-            break;
-        }
-
-        default:
-            throw std::runtime_error("Invalid type for mod(): only numeric types allowed");
-        }
+        pm_evaluate<ModOp>(parameters, return_address, current_memory);
     }
     static void floor(
         const std::vector<str>& parameters,
@@ -542,90 +566,7 @@ public:
         if (parameters.size() != 1)
             throw std::runtime_error("Error! floor() only takes a single parameter");
 
-        str val_1 = parameters[0];
-
-        if (val_1.front() == '$')
-            val_1 = current_memory.m_fetchStringalizedValue(val_1); // dereference variable
-
-        if (!___isNum___(val_1))
-            throw std::runtime_error(str("Bad values for function floor(): ") + val_1);
-
-        long double result = std::floor(std::stold(val_1)); // floor operation
-
-        auto ra = current_memory.m_getVariable(return_address);
-
-        // switch on return type, check bounds, cast, and store
-        switch (ra.second)
-        {
-        case ENUM_TYPE_I8:
-        {
-            if (result < -128 || result > 127)
-                throw std::runtime_error("Return address too small for floor");
-
-            int8_t val = static_cast<int8_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I8 });
-            break;
-        }
-
-        case ENUM_TYPE_I16:
-        {
-            if (result < -32768 || result > 32767)
-                throw std::runtime_error("Return address too small for floor");
-
-            int16_t val = static_cast<int16_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I16 });
-            break;
-        }
-
-        case ENUM_TYPE_I32:
-        {
-            if (result < INT32_MIN || result > INT32_MAX)
-                throw std::runtime_error("Return address too small for floor");
-
-            int32_t val = static_cast<int32_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I32 });
-            break;
-        }
-
-        case ENUM_TYPE_I64:
-        {
-            int64_t val = static_cast<int64_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I64 });
-            break;
-        }
-
-        case ENUM_TYPE_F32:
-        {
-            if (result < -FLT_MAX || result > FLT_MAX)
-                throw std::runtime_error("Return address too small for floor");
-
-            float val = static_cast<float>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F32 });
-            break;
-        }
-
-        case ENUM_TYPE_F64:
-        {
-            if (result < -DBL_MAX || result > DBL_MAX)
-                throw std::runtime_error("Return address too small for floor");
-
-            if (result < -DBL_MIN || result > DBL_MAX)
-                throw std::runtime_error("Return address too small for floor");
-
-            double val = static_cast<double>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F64 });
-            break;
-        }
-
-        case ENUM_TYPE_FMAX:
-        {
-            current_memory.m_reInsertVariable(return_address, { result, ENUM_TYPE_FMAX });
-            break;
-        }
-
-        default:
-            throw std::runtime_error("Invalid type for floor(): only numeric types allowed");
-        }
+        pm_evaluate<FloorOp>(parameters, return_address, current_memory);
     }
     static void ceiling(
         const std::vector<str>& parameters,
@@ -639,86 +580,7 @@ public:
         if (parameters.size() != 1)
             throw std::runtime_error("Error! ceiling() only takes a single parameter");
 
-        str val_1 = parameters[0];
-
-        if (val_1.front() == '$')
-            val_1 = current_memory.m_fetchStringalizedValue(val_1);
-
-        if (!___isNum___(val_1))
-            throw std::runtime_error(str("Bad values for function ceiling(): ") + val_1);
-
-        long double result = std::ceil(std::stold(val_1));
-
-        auto ra = current_memory.m_getVariable(return_address);
-
-        switch (ra.second)
-        {
-        case ENUM_TYPE_I8:
-        {
-            if (result < -128 || result > 127)
-                throw std::runtime_error("Return address too small for ceiling");
-
-            int8_t val = static_cast<int8_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I8 });
-            break;
-        }
-
-        case ENUM_TYPE_I16:
-        {
-            if (result < -32768 || result > 32767)
-                throw std::runtime_error("Return address too small for ceiling");
-
-            int16_t val = static_cast<int16_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I16 });
-            break;
-        }
-
-        case ENUM_TYPE_I32:
-        {
-            if (result < INT32_MIN || result > INT32_MAX)
-                throw std::runtime_error("Return address too small for ceiling");
-
-            int32_t val = static_cast<int32_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I32 });
-            break;
-        }
-
-        case ENUM_TYPE_I64:
-        {
-            int64_t val = static_cast<int64_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I64 });
-            break;
-        }
-
-        case ENUM_TYPE_F32:
-        {
-            if (result < -FLT_MAX || result > FLT_MAX)
-                throw std::runtime_error("Return address too small for ceiling");
-
-            float val = static_cast<float>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F32 });
-            break;
-        }
-
-        case ENUM_TYPE_F64:
-        {
-            if (result < -DBL_MAX || result > DBL_MAX)
-                throw std::runtime_error("Return address too small for ceiling");
-
-            double val = static_cast<double>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F64 });
-            break;
-        }
-
-        case ENUM_TYPE_FMAX:
-        {
-            current_memory.m_reInsertVariable(return_address, { result, ENUM_TYPE_FMAX });
-            break;
-        }
-
-        default:
-            throw std::runtime_error("Invalid type for ceiling(): only numeric types allowed");
-        }
+        pm_evaluate<CeilingOp>(parameters, return_address, current_memory);
     }
     static void abs(
         const std::vector<str>& parameters,
@@ -732,86 +594,7 @@ public:
         if (parameters.size() != 1)
             throw std::runtime_error("Error! abs() only takes a single parameter");
 
-        str val_1 = parameters[0];
-
-        if (val_1.front() == '$')
-            val_1 = current_memory.m_fetchStringalizedValue(val_1);
-
-        if (!___isNum___(val_1))
-            throw std::runtime_error(str("Bad values for function abs(): ") + val_1);
-
-        long double result = std::abs(std::stold(val_1));
-
-        auto ra = current_memory.m_getVariable(return_address);
-
-        switch (ra.second)
-        {
-        case ENUM_TYPE_I8:
-        {
-            if (result < -128 || result > 127)
-                throw std::runtime_error("Return address too small for absolute value!");
-
-            int8_t val = static_cast<int8_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I8 });
-            break;
-        }
-
-        case ENUM_TYPE_I16:
-        {
-            if (result < -32768 || result > 32767)
-                throw std::runtime_error("Return address too small for absolute value!");
-
-            int16_t val = static_cast<int16_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I16 });
-            break;
-        }
-
-        case ENUM_TYPE_I32:
-        {
-            if (result < INT32_MIN || result > INT32_MAX)
-                throw std::runtime_error("Return address too small for absolute value!");
-
-            int32_t val = static_cast<int32_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I32 });
-            break;
-        }
-
-        case ENUM_TYPE_I64:
-        {
-            int64_t val = static_cast<int64_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I64 });
-            break;
-        }
-
-        case ENUM_TYPE_F32:
-        {
-            if (result < -FLT_MAX || result > FLT_MAX)
-                throw std::runtime_error("Return address too small for absolute value!");
-
-            float val = static_cast<float>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F32 });
-            break;
-        }
-
-        case ENUM_TYPE_F64:
-        {
-            if (result < -DBL_MAX || result > DBL_MAX)
-                throw std::runtime_error("Return address too small for abs");
-
-            double val = static_cast<double>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F64 });
-            break;
-        }
-
-        case ENUM_TYPE_FMAX:
-        {
-            current_memory.m_reInsertVariable(return_address, { result, ENUM_TYPE_FMAX });
-            break;
-        }
-
-        default:
-            throw std::runtime_error("Invalid type for abs(): only numeric types allowed");
-        }
+        pm_evaluate<AbsOp>(parameters, return_address, current_memory);
     }
     static void pow(
         const std::vector<str>& parameters,
@@ -825,89 +608,7 @@ public:
         if (parameters.size() != 2)
             throw std::runtime_error("Error! pow() only takes two parameters!");
 
-        str val_1 = parameters[0];
-        str val_2 = parameters[1];
-
-        if (val_1.front() == '$')
-            val_1 = current_memory.m_fetchStringalizedValue(val_1);
-
-        if (val_2.front() == '$')
-            val_2 = current_memory.m_fetchStringalizedValue(val_2);
-
-        if (!___isNum___(val_1))
-            throw std::runtime_error(str("Bad values for function divide(): ") + val_1);
-
-        if (!___isNum___(val_2))
-            throw std::runtime_error(str("Bad values for function divide(): ") + val_2);
-        long double result = std::pow(std::stold(val_1), std::stold(val_2)); // compute power
-        auto ra = current_memory.m_getVariable(return_address);
-        switch (ra.second)
-        {
-        case ENUM_TYPE_I8:
-        {
-            if (result < -128 || result > 127)
-                throw std::runtime_error("Return address too small for pow");
-
-            int8_t val = static_cast<int8_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I8 });
-            break;
-        }
-
-        case ENUM_TYPE_I16:
-        {
-            if (result < -32768 || result > 32767)
-                throw std::runtime_error("Return address too small for pow");
-
-            int16_t val = static_cast<int16_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I16 });
-            break;
-        }
-
-        case ENUM_TYPE_I32:
-        {
-            if (result < INT32_MIN || result > INT32_MAX)
-                throw std::runtime_error("Return address too small for pow");
-
-            int32_t val = static_cast<int32_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I32 });
-            break;
-        }
-
-        case ENUM_TYPE_I64:
-        {
-            int64_t val = static_cast<int64_t>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_I64 });
-            break;
-        }
-
-        case ENUM_TYPE_F32:
-        {
-            if (result < -FLT_MAX || result > FLT_MAX)
-                throw std::runtime_error("Return address too small for pow");
-
-            float val = static_cast<float>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F32 });
-            break;
-        }
-
-        case ENUM_TYPE_F64:
-        {
-            if (result < -DBL_MAX || result > DBL_MAX)
-                throw std::runtime_error("Return address too small for pow");
-            double val = static_cast<double>(result);
-            current_memory.m_reInsertVariable(return_address, { val, ENUM_TYPE_F64 });
-            break;
-        }
-
-        case ENUM_TYPE_FMAX:
-        {
-            current_memory.m_reInsertVariable(return_address, { result, ENUM_TYPE_FMAX });
-            break;
-        }
-
-        default:
-            throw std::runtime_error("Invalid type for pow(): only numeric types allowed");
-        }
+        pm_evaluate<PowOp>(parameters, return_address, current_memory);
     }
 };
 
@@ -0,0 +1,132 @@
+#ifndef ___ASYNC___SINK___H___
+#define ___ASYNC___SINK___H___
+
+#include "includes.h"
+#include "IOSinks.h"
+
+// Puts a background thread between the program and a slow sink. write() only copies the
+// bytes into a single-producer/single-consumer ring and returns; the thread drains the
+// ring into the wrapped sink in large writes. When the ring is full, write() waits for
+// room, so a program can't run arbitrarily far ahead of its output. flush() returns once
+// everything written so far has reached the wrapped sink, and so does the destructor.
+//
+// One thread writes at a time (the VM's), which is what keeps the ring lock-free. If the
+// wrapped sink fails, the rest of the output is dropped and the error is rethrown by the
+// next write() or flush().
+class AsyncSink : public OutputSink {
+private:
+    std::shared_ptr<OutputSink> inner;
+    std::vector<char> ring;
+    size_t mask;
+
+    // Total bytes ever published and ever drained; the ring holds [tail, head).
+    alignas(64) std::atomic<size_t> head{ 0 };
+    alignas(64) std::atomic<size_t> tail{ 0 };
+    // Bumped after every publish and on shutdown, so the drainer can sleep on it.
+    alignas(64) std::atomic<uint64_t> events{ 0 };
+    std::atomic<bool> stopping{ false };
+    std::atomic<bool> failed{ false };
+    std::exception_ptr error;
+    std::thread drainer;
+
+    void pm_drain() {
+        for (;;) {
+            uint64_t seen = events.load(std::memory_order_acquire);
+            size_t from = tail.load(std::memory_order_relaxed);
+            size_t to = head.load(std::memory_order_acquire);
+            if (from == to) {
+                if (stopping.load(std::memory_order_acquire))
+                    return;
+                events.wait(seen, std::memory_order_acquire);
+                continue;
+            }
+            // At most up to the end of the ring; the wrapped part goes on the next round.
+            size_t start = from & mask;
+            size_t count = std::min(to - from, ring.size() - start);
+            if (!failed.load(std::memory_order_relaxed)) {
+                try {
+                    inner->write(std::string_view(ring.data() + start, count));
+                }
+                catch (...) {
+                    error = std::current_exception();
+                    failed.store(true, std::memory_order_release);
+                }
+            }
+            tail.store(from + count, std::memory_order_release);
+            tail.notify_all();
+        }
+    }
+
+    void pm_rethrow() {
+        if (failed.load(std::memory_order_acquire) && error) {
+            std::exception_ptr pending = std::exchange(error, nullptr);
+            std::rethrow_exception(pending);
+        }
+    }
+
+    // Sleeps until the drainer has moved tail to at least `until`.
+    void pm_waitFor(size_t until) {
+        size_t drained = tail.load(std::memory_order_acquire);
+        while (drained < until) {
+            tail.wait(drained, std::memory_order_acquire);
+            drained = tail.load(std::memory_order_acquire);
+        }
+    }
+
+public:
+    // capacity is rounded up to a power of two.
+    explicit AsyncSink(std::shared_ptr<OutputSink> to, size_t capacity = 1 << 22)
+        : inner(std::move(to)), ring(std::bit_ceil(std::max<size_t>(capacity, 1 << 12))) {
+        if (!inner)
+            throw std::runtime_error("AsyncSink needs a sink to write to!");
+        mask = ring.size() - 1;
+        drainer = std::thread([this] { pm_drain(); });
+    }
+
+    AsyncSink(const AsyncSink&) = delete;
+    AsyncSink& operator=(const AsyncSink&) = delete;
+
+    ~AsyncSink() override {
+        stopping.store(true, std::memory_order_release);
+        events.fetch_add(1, std::memory_order_release);
+        events.notify_one();
+        drainer.join();
+        try {
+            if (!failed.load(std::memory_order_acquire))
+                inner->flush();
+        }
+        catch (...) {}
+    }
+
+    void write(std::string_view bytes) override {
+        pm_rethrow();
+        size_t written = head.load(std::memory_order_relaxed);
+        while (!bytes.empty()) {
+            size_t room = ring.size() - (written - tail.load(std::memory_order_acquire));
+            if (room == 0) {
+                pm_waitFor(written + std::min(bytes.size(), ring.size()) - ring.size());
+                continue;
+            }
+            size_t count = std::min(room, bytes.size());
+            size_t start = written & mask;
+            size_t first = std::min(count, ring.size() - start);
+            std::memcpy(ring.data() + start, bytes.data(), first);
+            std::memcpy(ring.data(), bytes.data() + first, count - first);
+            written += count;
+            bytes.remove_prefix(count);
+            head.store(written, std::memory_order_release);
+            events.fetch_add(1, std::memory_order_release);
+            events.notify_one();
+        }
+    }
+
+    void flush() override {
+        pm_waitFor(head.load(std::memory_order_relaxed));
+        pm_rethrow();
+        // The drainer is idle until the next write(), so the wrapped sink is ours here.
+        inner->flush();
+    }
+
+    bool interactive() const override { return inner->interactive(); }
+};
+#endif
@@ -0,0 +1,310 @@
+#ifndef ___CSV___ENGINE___H___
+#define ___CSV___ENGINE___H___
+
+#include "MemoryModel.h"
+#include "ListEngine.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+
+// @csv_read : ("path", delimiter) ~ table reads a delimited file with a header row. Each column
+// becomes its own list, named table_<column> (characters other than letters, digits and '_'
+// become '_'), and the list table holds the column names in file order.
+// Columns whose fields all parse as integers become i64 lists, numeric columns become f64 lists
+// (an empty field reads as NaN there), and anything else stays a dynamic list of strings.
+class CsvEngine {
+private:
+    typedef std::vector<std::vector<std::string_view>> columns_t;
+
+    // Files at least this large are split at line boundaries and parsed on all cores.
+    static constexpr size_t pm_parallelThreshold = 1 << 20;
+
+    static std::string_view pm_trim(std::string_view field) {
+        while (!field.empty() && (field.front() == ' ' || field.front() == '\t'))
+            field.remove_prefix(1);
+        while (!field.empty() && (field.back() == ' ' || field.back() == '\t' || field.back() == '\r'))
+            field.remove_suffix(1);
+        return field;
+    }
+
+    template <typename T>
+    static bool pm_parseField(std::string_view field, T& out) {
+        field = pm_trim(field);
+        if (!field.empty() && field.front() == '+')
+            field.remove_prefix(1);
+        if (field.empty())
+            return false;
+        const char* last = field.data() + field.size();
+        std::from_chars_result result;
+        if constexpr (std::is_integral_v<T>)
+            result = std::from_chars(field.data(), last, out);
+        else
+            result = std::from_chars(field.data(), last, out, std::chars_format::general);
+        return result.ec == std::errc() && result.ptr == last;
+    }
+
+    // line_number counts from 1 at the header.
+    [[noreturn]] static void pm_badRow(size_t line_number) {
+        throw std::runtime_error("A row in csv_read() doesn't have as many fields as the header! (line " + std::to_string(line_number) + ")");
+    }
+
+    // Splits the unquoted lines in [begin, end) with memchr, which the C library vectorizes.
+    // first_line is 0 for a parallel chunk, which doesn't know where it starts.
+    static void pm_splitPlain(const char* begin, const char* end, char delimiter, columns_t& columns, size_t first_line) {
+        size_t line_number = first_line;
+        while (begin < end) {
+            const char* line_end = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+            if (!line_end)
+                line_end = end;
+            const char* content_end = line_end > begin && line_end[-1] == '\r' ? line_end - 1 : line_end;
+            const char* cursor = begin;
+            size_t column = 0;
+            bool blank = pm_trim(std::string_view(begin, static_cast<size_t>(content_end - begin))).empty();
+            while (!blank) {
+                const char* field_end = static_cast<const char*>(std::memchr(cursor, delimiter, static_cast<size_t>(content_end - cursor)));
+                bool last_field = !field_end;
+                if (last_field)
+                    field_end = content_end;
+                if (column == columns.size())
+                    pm_badRow(line_number);
+                columns[column++].emplace_back(cursor, static_cast<size_t>(field_end - cursor));
+                if (last_field)
+                    break;
+                cursor = field_end + 1;
+            }
+            if (!blank && column != columns.size())
+                pm_badRow(line_number);
+            begin = line_end + 1;
+            if (line_number)
+                ++line_number;
+        }
+    }
+
+    // RFC 4180 quoting: fields may be wrapped in double quotes, which may hold delimiters,
+    // newlines and "" for a literal quote. Unescaped fields are kept in unescaped_fields.
+    static void pm_splitQuoted(const char* begin, const char* end, char delimiter, columns_t& columns,
+        std::deque<str>& unescaped_fields) {
+        size_t line_number = 2;
+        size_t column = 0;
+        bool row_has_content = false;
+        const char* cursor = begin;
+        while (cursor <= end) {
+            std::string_view field;
+            if (cursor < end && *cursor == '"') {
+                str& text = unescaped_fields.emplace_back();
+                ++cursor;
+                for (;;) {
+                    if (cursor >= end)
+                        throw std::runtime_error("Unterminated quoted field in csv_read()!");
+                    if (*cursor == '"') {
+                        if (cursor + 1 < end && cursor[1] == '"') {
+                            text += '"';
+                            cursor += 2;
+                            continue;
+                        }
+                        ++cursor;
+                        break;
+                    }
+                    if (*cursor == '\n')
+                        ++line_number;
+                    text += *cursor++;
+                }
+                field = text;
+                while (cursor < end && *cursor != delimiter && *cursor != '\n')
+                    ++cursor;
+                row_has_content = true;
+            }
+            else {
+                const char* field_start = cursor;
+                while (cursor < end && *cursor != delimiter && *cursor != '\n')
+                    ++cursor;
+                field = std::string_view(field_start, static_cast<size_t>(cursor - field_start));
+                if (!field.empty() && field.back() == '\r')
+                    field.remove_suffix(1);
+                row_has_content = row_has_content || !pm_trim(field).empty() || (cursor < end && *cursor == delimiter);
+            }
+
+            bool end_of_row = cursor >= end || *cursor == '\n';
+            if (row_has_content) {
+                if (column == columns.size())
+                    pm_badRow(line_number);
+                columns[column++].push_back(field);
+            }
+            if (end_of_row) {
+                if (row_has_content && column != columns.size())
+                    pm_badRow(line_number);
+                column = 0;
+                row_has_content = false;
+                ++line_number;
+            }
+            ++cursor;
+        }
+    }
+
+    static char pm_readDelimiter(const str& token, SectionMemory& current_memory) {
+        if (token == "tab")
+            return '\t';
+        value_t value = ListEngine::parseItem(token, current_memory, "csv_read");
+        if (value.second == ENUM_TYPE_CHAR)
+            return std::get<char>(value.first);
+        if (value.second == ENUM_TYPE_STRING) {
+            const str& text = std::get<str>(value.first);
+            if (text.size() == 1 && text != "\"" && text != "\n")
+                return text[0];
+            if (text == "\\t")
+                return '\t';
+        }
+        throw std::runtime_error("The delimiter for csv_read() must be a single character, e.g. \",\" or tab!");
+    }
+
+    static str pm_columnListName(const str& table, std::string_view column) {
+        str name = table + '_';
+        for (char ch : pm_trim(column))
+            name += std::isalnum(static_cast<unsigned char>(ch)) || ch == '_' ? ch : '_';
+        return name;
+    }
+
+    // Picks the narrowest of i64, f64 and string that holds every field, then converts.
+    static ListValue pm_buildColumn(const std::vector<std::string_view>& fields) {
+        bool integers = true, numbers = true;
+        for (std::string_view field : fields) {
+            int64_t integer;
+            double real;
+            if (integers && pm_parseField(field, integer))
+                continue;
+            integers = false;
+            if (!pm_parseField(field, real) && !pm_trim(field).empty()) {
+                numbers = false;
+                break;
+            }
+        }
+        if (integers) {
+            std::vector<int64_t> values(fields.size());
+            for (size_t idx = 0; idx < fields.size(); ++idx)
+                pm_parseField(fields[idx], values[idx]);
+            return ListValue(std::move(values));
+        }
+        if (numbers) {
+            std::vector<double> values(fields.size());
+            for (size_t idx = 0; idx < fields.size(); ++idx)
+                if (!pm_parseField(fields[idx], values[idx]))
+                    values[idx] = std::numeric_limits<double>::quiet_NaN();
+            return ListValue(std::move(values));
+        }
+        std::vector<value_t> values;
+        values.reserve(fields.size());
+        for (std::string_view field : fields)
+            values.push_back({ str(field), ENUM_TYPE_STRING });
+        return ListValue(std::move(values));
+    }
+
+public:
+    static void csv_read(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2 || return_address == "nullptr")
+            throw std::runtime_error("csv_read() requires a path and a delimiter! Syntax: (\"path\", delimiter) ~ table");
+        value_t path = ListEngine::parseItem(parameters[0], current_memory, "csv_read");
+        if (path.second != ENUM_TYPE_STRING)
+            throw std::runtime_error("The path for csv_read() must be a string!");
+        char delimiter = pm_readDelimiter(parameters[1], current_memory);
+
+        std::shared_ptr<const MappedFile> file = MappedFile::open(std::get<str>(path.first));
+        const char* begin = file->data();
+        const char* end = begin + file->size();
+        if (file->size() >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0)
+            begin += 3;
+
+        // Header row. Quoted header names are not unescaped.
+        const char* header_end = begin == end ? end : static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+        if (!header_end)
+            header_end = end;
+        std::vector<std::string_view> names;
+        for (const char* cursor = begin;;) {
+            const char* field_end = static_cast<const char*>(std::memchr(cursor, delimiter, static_cast<size_t>(header_end - cursor)));
+            std::string_view name(cursor, static_cast<size_t>((field_end ? field_end : header_end) - cursor));
+            name = pm_trim(name);
+            if (name.size() >= 2 && name.front() == '"' && name.back() == '"')
+                name = name.substr(1, name.size() - 2);
+            names.push_back(name);
+            if (!field_end)
+                break;
+            cursor = field_end + 1;
+        }
+        if (names.size() == 1 && names[0].empty())
+            throw std::runtime_error("csv_read() found no header row!");
+        // Headers that only differ in the characters pm_columnListName replaces would share a list.
+        std::vector<str> list_names;
+        UnorderedMap<str, size_t> first_column;
+        for (size_t column = 0; column < names.size(); ++column) {
+            list_names.push_back(pm_columnListName(return_address, names[column]));
+            auto [found, inserted] = first_column.try_emplace(list_names.back(), column);
+            if (!inserted)
+                throw std::runtime_error("The columns \"" + str(names[found->second]) + "\" and \"" + str(names[column]) +
+                    "\" both become the list " + list_names.back() + " in csv_read()!");
+        }
+        const char* body = header_end == end ? end : header_end + 1;
+
+        columns_t columns(names.size());
+        std::deque<str> unescaped_fields;
+        size_t body_size = static_cast<size_t>(end - body);
+        if (std::memchr(body, '"', body_size)) {
+            pm_splitQuoted(body, end, delimiter, columns, unescaped_fields);
+        }
+        else if (body_size < pm_parallelThreshold || Parallel::workerCount() < 2) {
+            pm_splitPlain(body, end, delimiter, columns, 2);
+        }
+        else {
+            // Without quotes a newline always ends a row, so chunks can start right after any newline.
+            size_t chunk_count = Parallel::workerCount() * 4;
+            std::vector<const char*> bounds{ body };
+            for (size_t chunk = 1; chunk < chunk_count; ++chunk) {
+                const char* guess = std::max(bounds.back(), body + body_size * chunk / chunk_count);
+                const char* newline = static_cast<const char*>(std::memchr(guess, '\n', static_cast<size_t>(end - guess)));
+                if (!newline)
+                    break;
+                if (newline + 1 > bounds.back())
+                    bounds.push_back(newline + 1);
+            }
+            bounds.push_back(end);
+
+            std::vector<columns_t> parts(bounds.size() - 1, columns_t(names.size()));
+            try {
+                Parallel::forChunks(parts.size(), 1, [&](size_t first, size_t last) {
+                    for (size_t part = first; part < last; ++part)
+                        pm_splitPlain(bounds[part], bounds[part + 1], delimiter, parts[part], 0);
+                    });
+            }
+            catch (const std::runtime_error&) {
+                // A chunk found a malformed row; splitting again from the top reports its real line.
+                columns_t counted(names.size());
+                pm_splitPlain(body, end, delimiter, counted, 2);
+                throw;
+            }
+            for (size_t column = 0; column < names.size(); ++column) {
+                size_t total = 0;
+                for (auto& part : parts)
+                    total += part[column].size();
+                columns[column].reserve(total);
+                for (auto& part : parts)
+                    columns[column].insert(columns[column].end(), part[column].begin(), part[column].end());
+            }
+        }
+
+        std::vector<ListValue> lists(names.size());
+        Parallel::forChunks(names.size(), 1, [&](size_t first, size_t last) {
+            for (size_t column = first; column < last; ++column)
+                lists[column] = pm_buildColumn(columns[column]);
+            });
+
+        std::vector<value_t> column_names;
+        for (size_t column = 0; column < names.size(); ++column) {
+            column_names.push_back({ str(names[column]), ENUM_TYPE_STRING });
+            ListEngine::storeList(current_memory, list_names[column], std::move(lists[column]));
+        }
+        ListEngine::storeList(current_memory, return_address, ListValue(std::move(column_names)));
+    }
+};
+#endif
+
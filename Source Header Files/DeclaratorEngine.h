@@ -33,6 +33,60 @@ private:
     }
 
 public:
+    // Decodes the inside of a char literal: a single character or an escape such as \n, \x41 or \101.
+    static char decodeChar(const str& value, const str& name)
+    {
+        char c;
+
+        if (value.front() == '\\')
+        {
+            if (value.size() == 2)
+            {
+                switch (value[1])
+                {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'v': c = '\v'; break;
+                case '\\': c = '\\'; break;
+                case '\'': c = '\''; break;
+                case '"': c = '"'; break;
+                case '0': c = '\0'; break;
+                default:
+                    throw std::runtime_error("Unknown escape sequence '\\" + std::string(1, value[1]) + "' for '" + name + "'");
+                }
+            }
+            else if (value[1] == 'x')
+            {
+                if (value.size() != 4)
+                    throw std::runtime_error("Invalid hex escape length for '" + name + "'");
+
+                int hexVal = NumberConversion::parse<int>(std::string_view(value).substr(2, 2), 16);
+                c = static_cast<char>(hexVal);
+            }
+            else if (isdigit(value[1]) && value[1] >= '0' && value[1] <= '7')
+            {
+                int len = std::min(3, static_cast<int>(value.size() - 1));
+                int octVal = NumberConversion::parse<int>(std::string_view(value).substr(1, len), 8);
+                c = static_cast<char>(octVal);
+            }
+            else
+            {
+                throw std::runtime_error("Unknown escape format for '" + name + "'");
+            }
+        }
+        else
+        {
+            if (value.size() != 1)
+                throw std::runtime_error("Fatal error! char length must be 1 for '" + name + "'");
+
+            c = value[0];
+        }
+
+        return c;
+    }
     static void new_i8
     (
         const std::vector<str>& parameters,
@@ -52,7 +106,7 @@ public:
             throw std::runtime_error(std::string("Variable '") + name + "' already exists!");
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
-        long long raw_value = std::stoll(value); 
+        long long raw_value = NumberConversion::parse<int64_t>(value); 
         if (raw_value < -128 || raw_value > 127)
             throw std::runtime_error(std::string("Overflow: value for '") + name + std::string("' cannot fit in i8."));
 
@@ -86,7 +140,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        long long raw_value = std::stoll(value);
+        long long raw_value = NumberConversion::parse<int64_t>(value);
 
         if (raw_value < -32768 || raw_value > 32767)
             throw std::runtime_error(std::string("Overflow: value for '") + name + "' cannot fit in i16.");
@@ -121,7 +175,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        long long raw_value = std::stoll(value);
+        long long raw_value = NumberConversion::parse<int64_t>(value);
 
         if (raw_value < INT32_MIN || raw_value > INT32_MAX)
             throw std::runtime_error(std::string("Overflow: value for '") + name + "' cannot fit in i32.");
@@ -156,7 +210,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        long long raw_value = std::stoll(value);
+        long long raw_value = NumberConversion::parse<int64_t>(value);
 
         int64_t value_i64 = static_cast<int64_t>(raw_value);
         value_t valtValue = { value_i64, ENUM_TYPE_I64 };
@@ -188,7 +242,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        float raw_value = std::stof(value);
+        float raw_value = NumberConversion::parse<float>(value);
         value_t valtValue = { raw_value, ENUM_TYPE_F32 };
 
         current_memory.m_insertVariable(name, valtValue);
@@ -218,7 +272,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        double raw_value = std::stod(value);
+        double raw_value = NumberConversion::parse<double>(value);
         value_t valtValue = { raw_value, ENUM_TYPE_F64 };
 
         current_memory.m_insertVariable(name, valtValue);
@@ -248,7 +302,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        long double raw_value = std::stold(value);
+        long double raw_value = NumberConversion::parse<long double>(value);
         value_t valtValue = { raw_value, ENUM_TYPE_FMAX };
 
         current_memory.m_insertVariable(name, valtValue);
@@ -314,54 +368,7 @@ public:
             value = value.substr(1, value.size() - 2);
         }
 
-        char c;
-
-        if (value.front() == '\\')
-        {
-            if (value.size() == 2)
-            {
-                switch (value[1])
-                {
-                case 'n': c = '\n'; break;
-                case 't': c = '\t'; break;
-                case 'r': c = '\r'; break;
-                case 'b': c = '\b'; break;
-                case 'f': c = '\f'; break;
-                case 'v': c = '\v'; break;
-                case '\\': c = '\\'; break;
-                case '\'': c = '\''; break;
-                case '"': c = '"'; break;
-                case '0': c = '\0'; break;
-                default:
-                    throw std::runtime_error("Unknown escape sequence '\\" + std::string(1, value[1]) + "' for '" + name + "'");
-                }
-            }
-            else if (value[1] == 'x')
-            {
-                if (value.size() != 4)
-                    throw std::runtime_error("Invalid hex escape length for '" + name + "'");
-
-                int hexVal = std::stoi(value.substr(2, 2), nullptr, 16);
-                c = static_cast<char>(hexVal);
-            }
-            else if (isdigit(value[1]) && value[1] >= '0' && value[1] <= '7')
-            {
-                int len = std::min(3, static_cast<int>(value.size() - 1));
-                int octVal = std::stoi(value.substr(1, len), nullptr, 8);
-                c = static_cast<char>(octVal);
-            }
-            else
-            {
-                throw std::runtime_error("Unknown escape format for '" + name + "'");
-            }
-        }
-        else
-        {
-            if (value.size() != 1)
-                throw std::runtime_error("Fatal error! char length must be 1 for '" + name + "'");
-
-            c = value[0];
-        }
+        char c = decodeChar(value, name);
 
         if (current_memory.m_containsVariable(name))
             throw std::runtime_error("Variable '" + name + "' already exists! Consider using reAssign_char()");
@@ -429,7 +436,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        long long raw_value = std::stoll(value);
+        long long raw_value = NumberConversion::parse<int64_t>(value);
 
         if (raw_value < -128 || raw_value > 127)
             throw std::runtime_error(std::string("Overflow: value for '") + name + "' cannot fit in i8.");
@@ -465,7 +472,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        long long raw_value = std::stoll(value);
+        long long raw_value = NumberConversion::parse<int64_t>(value);
 
         if (raw_value < -32768 || raw_value > 32767)
             throw std::runtime_error(std::string("Overflow: value for '") + name + "' cannot fit in i16.");
@@ -501,7 +508,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        long long raw_value = std::stoll(value);
+        long long raw_value = NumberConversion::parse<int64_t>(value);
 
         if (raw_value < INT32_MIN || raw_value > INT32_MAX)
             throw std::runtime_error(std::string("Overflow: value for '") + name + "' cannot fit in i32.");
@@ -537,7 +544,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        long long raw_value = std::stoll(value);
+        long long raw_value = NumberConversion::parse<int64_t>(value);
 
         int64_t value_i64 = static_cast<int64_t>(raw_value);
         value_t valtValue = { value_i64, ENUM_TYPE_I64 };
@@ -570,7 +577,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        float raw_value = std::stof(value);
+        float raw_value = NumberConversion::parse<float>(value);
         value_t valtValue = { raw_value, ENUM_TYPE_F32 };
 
         current_memory.m_reInsertVariable(name, valtValue);
@@ -601,7 +608,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        double raw_value = std::stod(value);
+        double raw_value = NumberConversion::parse<double>(value);
         value_t valtValue = { raw_value, ENUM_TYPE_F64 };
 
         current_memory.m_reInsertVariable(name, valtValue);
@@ -632,7 +639,7 @@ public:
         if (!___isNum___(value))
             throw std::runtime_error("Value must be a valid number!");
 
-        long double raw_value = std::stold(value);
+        long double raw_value = NumberConversion::parse<long double>(value);
         value_t valtValue = { raw_value, ENUM_TYPE_FMAX };
 
         current_memory.m_reInsertVariable(name, valtValue);
@@ -701,54 +708,7 @@ public:
             value = value.substr(1, value.size() - 2);
         }
 
-        char c;
-
-        if (value.front() == '\\')
-        {
-            if (value.size() == 2)
-            {
-                switch (value[1])
-                {
-                case 'n': c = '\n'; break;
-                case 't': c = '\t'; break;
-                case 'r': c = '\r'; break;
-                case 'b': c = '\b'; break;
-                case 'f': c = '\f'; break;
-                case 'v': c = '\v'; break;
-                case '\\': c = '\\'; break;
-                case '\'': c = '\''; break;
-                case '"': c = '"'; break;
-                case '0': c = '\0'; break;
-                default:
-                    throw std::runtime_error("Unknown escape sequence '\\" + std::string(1, value[1]) + "' for '" + name + "'");
-                }
-            }
-            else if (value[1] == 'x')
-            {
-                if (value.size() != 4)
-                    throw std::runtime_error("Invalid hex escape length for '" + name + "'");
-
-                int hexVal = std::stoi(value.substr(2, 2), nullptr, 16);
-                c = static_cast<char>(hexVal);
-            }
-            else if (isdigit(value[1]) && value[1] >= '0' && value[1] <= '7')
-            {
-                int len = std::min(3, static_cast<int>(value.size() - 1));
-                int octVal = std::stoi(value.substr(1, len), nullptr, 8);
-                c = static_cast<char>(octVal);
-            }
-            else
-            {
-                throw std::runtime_error("Unknown escape format for '" + name + "'");
-            }
-        }
-        else
-        {
-            if (value.size() != 1)
-                throw std::runtime_error("Fatal error! char length must be 1 for '" + name + "'");
-
-            c = value[0];
-        }
+        char c = decodeChar(value, name);
 
         if (!current_memory.m_containsVariable(name))
             throw std::runtime_error(std::string("Variable '") + name + "' doesn't exist!");
@@ -0,0 +1,150 @@
+#ifndef ___DICT___ENGINE___H___
+#define ___DICT___ENGINE___H___
+
+#include "MemoryModel.h"
+#include "ListEngine.h"
+
+class DictEngine {
+private:
+    static void pm_requireReturn(const str& return_address, SectionMemory& current_memory, const char* function_name) {
+        if (!current_memory.m_containsVariable(return_address))
+            throw std::runtime_error(str("Couldn't find the return_address, in the function ") + function_name + "()!");
+    }
+
+public:
+    static void new_dict(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("new_dict() requires exactly one parameter! Syntax: (dict_name)");
+        current_memory.m_insertDict(parameters[0]);
+    }
+    static void delete_dict(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("delete_dict() requires exactly one parameter! Syntax: (dict_name)");
+        current_memory.m_removeDict(parameters[0]);
+    }
+    static void dict_set(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 3)
+            throw std::runtime_error("dict_set() requires three parameters! Syntax: (dict_name, key, value)");
+        DictValue& dict = current_memory.m_getDict(parameters[0]);
+        dict.m_set(ListEngine::parseItem(parameters[1], current_memory, "dict_set"),
+            ListEngine::parseItem(parameters[2], current_memory, "dict_set"));
+    }
+    // dict_get : (d, key) ~ x fails on a missing key; dict_get : (d, key, fallback) ~ x returns the fallback.
+    static void dict_get(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2 && parameters.size() != 3)
+            throw std::runtime_error("dict_get() requires two or three parameters! Syntax: (dict_name, key[, fallback]) ~ result");
+        pm_requireReturn(return_address, current_memory, "dict_get");
+
+        const DictValue& dict = current_memory.m_getDict(parameters[0]);
+        const value_t* found = dict.m_find(ListEngine::parseItem(parameters[1], current_memory, "dict_get"));
+        if (found) {
+            current_memory.m_reInsertVariable(return_address, *found);
+            return;
+        }
+        if (parameters.size() == 3) {
+            current_memory.m_reInsertVariable(return_address, ListEngine::parseItem(parameters[2], current_memory, "dict_get"));
+            return;
+        }
+        throw std::runtime_error("Key not found in dict_get()! (" + parameters[1] + ")");
+    }
+    static void dict_has(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2)
+            throw std::runtime_error("dict_has() requires two parameters! Syntax: (dict_name, key) ~ bool_result");
+        pm_requireReturn(return_address, current_memory, "dict_has");
+        const DictValue& dict = current_memory.m_getDict(parameters[0]);
+        bool found = dict.m_find(ListEngine::parseItem(parameters[1], current_memory, "dict_has")) != nullptr;
+        current_memory.m_reInsertVariable(return_address, { found, ENUM_TYPE_BOOL });
+    }
+    static void dict_erase(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2)
+            throw std::runtime_error("dict_erase() requires two parameters! Syntax: (dict_name, key)");
+        DictValue& dict = current_memory.m_getDict(parameters[0]);
+        bool erased = dict.m_erase(ListEngine::parseItem(parameters[1], current_memory, "dict_erase"));
+        if (return_address != "nullptr") {
+            pm_requireReturn(return_address, current_memory, "dict_erase");
+            current_memory.m_reInsertVariable(return_address, { erased, ENUM_TYPE_BOOL });
+        }
+    }
+    static void dict_size(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("dict_size() requires exactly one parameter! Syntax: (dict_name) ~ result");
+        pm_requireReturn(return_address, current_memory, "dict_size");
+        int64_t size = static_cast<int64_t>(current_memory.m_getDict(parameters[0]).m_size());
+        current_memory.m_reInsertVariable(return_address, { size, ENUM_TYPE_I64 });
+    }
+    // Iteration goes through lists: keys and values come out in the same (unspecified) order.
+    static void dict_keys(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("dict_keys() requires exactly one parameter! Syntax: (dict_name) ~ list_name");
+        ListEngine::storeList(current_memory, return_address, current_memory.m_getDict(parameters[0]).m_keys());
+    }
+    static void dict_values(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("dict_values() requires exactly one parameter! Syntax: (dict_name) ~ list_name");
+        ListEngine::storeList(current_memory, return_address, current_memory.m_getDict(parameters[0]).m_values());
+    }
+    static void printDict(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 3)
+            throw std::runtime_error("printDict() requires 3 parameter!");
+
+        str head = parameters[1];
+        str tail = parameters[2];
+        if (head.front() == '$')
+            head = current_memory.m_fetchStringalizedValue(head);
+        if (tail.front() == '$')
+            tail = current_memory.m_fetchStringalizedValue(tail);
+        if (head.front() == '"' && head.back() == '"')
+            head = head.substr(1, head.length() - 2);
+        if (tail.front() == '"' && tail.back() == '"')
+            tail = tail.substr(1, tail.length() - 2);
+
+        const auto& value = current_memory.m_getDict(parameters[0]);
+        OutputBuffer& output = current_memory.m_output();
+        output.text() += head;
+        value.m_appendTo(output.text());
+        output.text() += tail;
+        output.commit();
+    }
+};
+#endif
+
@@ -0,0 +1,105 @@
+#ifndef ___FILE___ENGINE___H___
+#define ___FILE___ENGINE___H___
+
+#include "MemoryModel.h"
+#include "ListEngine.h"
+#include "IOEngine.h"
+// File I/O for programs. Handles live in their own namespace like lists and dictionaries:
+//   @open : ("path", "r") ~ f;        "r", "w" (truncate) or "a" (append); "r" by default
+//   @read_line : (f) ~ line;          the next line, or "" at the end of the file
+//   @file_eof : (f) ~ done;           true once every line has been read
+//   @foreach_line : (f) ~ line; ... @end : (line);
+//   @write : (f, "x = ", $x);         like @print
+//   @writeln : (f, "x = ", $x);       like @write, then ends the line
+//   @close : (f);
+// Reading maps the file, so a line is only copied when it is stored into a variable.
+class FileEngine {
+private:
+    static std::string pm_readText(const str& token, SectionMemory& current_memory, const char* function_name, const char* what) {
+        value_t value = ListEngine::parseItem(token, current_memory, function_name);
+        if (value.second != ENUM_TYPE_STRING)
+            throw std::runtime_error(str("The ") + what + " for " + function_name + "() must be a string!");
+        return std::move(std::get<str>(value.first));
+    }
+
+public:
+    // Stores a line into a variable. A string variable keeps its allocation when the new line fits.
+    static void storeLine(SectionMemory& current_memory, const str& return_address, std::string_view line) {
+        if (str* slot = current_memory.m_findTyped<str>(return_address))
+            slot->assign(line);
+        else
+            current_memory.m_reInsertVariable(return_address, { str(line), ENUM_TYPE_STRING });
+    }
+
+    static void open(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.empty() || parameters.size() > 2 || return_address == "nullptr")
+            throw std::runtime_error("open() requires a path and an optional mode! Syntax: (\"path\", \"r\") ~ file_name");
+        str path = pm_readText(parameters[0], current_memory, "open", "path");
+        str mode = parameters.size() == 2 ? pm_readText(parameters[1], current_memory, "open", "mode") : "r";
+        current_memory.m_insertFile(return_address, FileHandle::open(path, mode));
+    }
+    static void read_line(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("read_line() requires exactly one parameter! Syntax: (file_name) ~ string_name");
+        FileHandle& file = current_memory.m_getFile(parameters[0]);
+        if (!file.isReadable())
+            throw std::runtime_error("read_line() needs a file opened with \"r\"!");
+        std::string_view line;
+        file.nextLine(line);
+        if (return_address != "nullptr")
+            storeLine(current_memory, return_address, line);
+    }
+    static void file_eof(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("file_eof() requires exactly one parameter! Syntax: (file_name) ~ bool_name");
+        bool done = current_memory.m_getFile(parameters[0]).atEnd();
+        if (return_address != "nullptr")
+            current_memory.m_reInsertVariable(return_address, { done, ENUM_TYPE_BOOL });
+    }
+    static void write(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.empty())
+            throw std::runtime_error("write() requires a file! Syntax: (file_name, items...)");
+        OutputBuffer& out = current_memory.m_getFile(parameters[0]).out();
+        IOEngine::writeItems(out, std::span<const str>(parameters).subspan(1), current_memory, false);
+    }
+    static void writeln(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.empty())
+            throw std::runtime_error("writeln() requires a file! Syntax: (file_name, items...)");
+        OutputBuffer& out = current_memory.m_getFile(parameters[0]).out();
+        IOEngine::writeItems(out, std::span<const str>(parameters).subspan(1), current_memory, false);
+        out.text() += '\n';
+        out.commit();
+    }
+    static void close(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("close() requires exactly one parameter! Syntax: (file_name)");
+        // Closed before it's dropped, so a failing final write is reported here.
+        current_memory.m_getFile(parameters[0]).close();
+        current_memory.m_removeFile(parameters[0]);
+    }
+};
+#endif
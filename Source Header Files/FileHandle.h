@@ -0,0 +1,112 @@
+#ifndef ___FILE___HANDLE___H___
+#define ___FILE___HANDLE___H___
+
+#include "includes.h"
+#include "MappedFile.h"
+#include "OutputBuffer.h"
+#if defined(_WIN32)
+#    include <fcntl.h>
+#    include <io.h>
+#endif
+
+// A file opened by a program with @open. Files opened for reading are mapped with
+// MappedFile and read through a cursor, so a line is just a view into the mapping until
+// the program stores it. Files opened for writing or appending go through their own
+// OutputBuffer, exactly like the program's standard output.
+class FileHandle {
+private:
+    std::string path;
+    std::shared_ptr<const MappedFile> mapped;
+    size_t position = 0;
+    int descriptor = -1;
+    std::unique_ptr<OutputBuffer> output;
+
+    FileHandle() = default;
+
+public:
+    FileHandle(const FileHandle&) = delete;
+    FileHandle& operator=(const FileHandle&) = delete;
+
+    ~FileHandle() {
+        try { close(); }
+        catch (...) {}
+    }
+
+    // mode is "r", "w" (truncates) or "a" (appends); missing files are created for the latter two.
+    static std::shared_ptr<FileHandle> open(const std::string& path, const std::string& mode) {
+        std::shared_ptr<FileHandle> file(new FileHandle());
+        file->path = path;
+        if (mode == "r") {
+            file->mapped = MappedFile::open(path, true);
+            return file;
+        }
+        if (mode != "w" && mode != "a")
+            throw std::runtime_error("Unknown file mode '" + mode + "'! Use \"r\", \"w\" or \"a\".");
+#if defined(_WIN32)
+        int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (mode == "w" ? _O_TRUNC : _O_APPEND);
+        file->descriptor = ::_open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+        int flags = O_WRONLY | O_CREAT | (mode == "w" ? O_TRUNC : O_APPEND);
+        file->descriptor = ::open(path.c_str(), flags, 0644);
+#endif
+        if (file->descriptor < 0) {
+            throw std::runtime_error("Couldn't open the file for writing! (" + path + ")");
+        }
+        file->output = std::make_unique<OutputBuffer>(std::make_shared<FdSink>(file->descriptor));
+        return file;
+    }
+
+    const std::string& name() const { return path; }
+    bool isReadable() const { return mapped != nullptr; }
+    bool isWritable() const { return output != nullptr; }
+
+    // True once every line has been read.
+    bool atEnd() const { return !mapped || position >= mapped->size(); }
+
+    // Points line at the next line, without its line ending. The view stays valid for as long
+    // as the handle is open. Returns false at the end of the file.
+    bool nextLine(std::string_view& line) {
+        if (atEnd())
+            return false;
+        const char* begin = mapped->data() + position;
+        size_t remaining = mapped->size() - position;
+        const void* newline = std::memchr(begin, '\n', remaining);
+        size_t length = newline ? static_cast<const char*>(newline) - begin : remaining;
+        position += newline ? length + 1 : length;
+        line = std::string_view(begin, length);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        return true;
+    }
+
+    OutputBuffer& out() {
+        if (!output) {
+            throw std::runtime_error("The file wasn't opened for writing! (" + path + ")");
+        }
+        return *output;
+    }
+
+    // Flushes pending output and releases the file. Closing twice does nothing.
+    void close() {
+        mapped.reset();
+        if (descriptor < 0)
+            return;
+        int closing = std::exchange(descriptor, -1);
+        std::unique_ptr<OutputBuffer> pending = std::move(output);
+        try { pending->flush(); }
+        catch (...) {
+#if defined(_WIN32)
+            ::_close(closing);
+#else
+            ::close(closing);
+#endif
+            throw;
+        }
+#if defined(_WIN32)
+        ::_close(closing);
+#else
+        ::close(closing);
+#endif
+    }
+};
+#endif
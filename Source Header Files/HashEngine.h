@@ -0,0 +1,69 @@
+#ifndef ___HASH___ENGINE___H___
+#define ___HASH___ENGINE___H___
+
+#include "MemoryModel.h"
+#include "ListEngine.h"
+#include "Parallel.h"
+// Hashes values with the function dictionaries use for their keys (robin_hood's hash_bytes and
+// hash_int), so equal keys hash equally: 2, 2.0 and an i8 holding 2 all agree, while true,
+// 1 and a char never collide by construction. Hashes are 64-bit and stored in i64 variables.
+//   @hash : ($s) ~ h;
+//   @hash_list : (xs) ~ hs;      an i64 list with one hash per element
+class HashEngine {
+private:
+    template <typename T>
+    static int64_t pm_hash(const T& value) {
+        using Hash = DictValue::KeyHash;
+        size_t h;
+        if constexpr (std::is_same_v<T, value_t>)
+            return std::visit([](const auto& v) { return pm_hash(v); }, value.first);
+        else if constexpr (std::is_same_v<T, str> || std::is_same_v<T, bool> || std::is_same_v<T, char>)
+            h = Hash::m_hash(value);
+        else if constexpr (std::is_integral_v<T>)
+            h = Hash::m_hash(static_cast<int64_t>(value));
+        else if (std::isnan(value))
+            h = Hash::m_hash(std::numeric_limits<double>::quiet_NaN());
+        else if (std::trunc(value) == value && value >= -0x1p63L && value < 0x1p63L)
+            h = Hash::m_hash(static_cast<int64_t>(value));
+        else
+            h = Hash::m_hash(static_cast<double>(value));
+        return static_cast<int64_t>(h);
+    }
+
+public:
+    static void hash(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("hash() requires exactly one parameter! Syntax: (value) ~ i64_name");
+        const str& item = parameters[0];
+        int64_t h;
+        // String variables are hashed in place instead of being copied out first.
+        if (const str* text = item.size() > 1 && item.front() == '$' ? current_memory.m_findTyped<str>(item.substr(1)) : nullptr)
+            h = pm_hash(*text);
+        else
+            h = pm_hash(ListEngine::parseItem(item, current_memory, "hash"));
+        if (return_address != "nullptr")
+            current_memory.m_reInsertVariable(return_address, { h, ENUM_TYPE_I64 });
+    }
+    static void hash_list(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1 || return_address == "nullptr")
+            throw std::runtime_error("hash_list() requires exactly one parameter! Syntax: (list_name) ~ list_name");
+        const ListValue& list = current_memory.m_getList(parameters[0]);
+        std::vector<int64_t> hashes(list.m_size());
+        list.m_visit([&hashes](auto values) {
+            Parallel::forChunks(values.size(), 1 << 14, [&](size_t begin, size_t end) {
+                for (size_t idx = begin; idx < end; ++idx)
+                    hashes[idx] = pm_hash(values[idx]);
+                });
+            });
+        ListEngine::storeList(current_memory, return_address, ListValue(std::move(hashes)));
+    }
+};
+#endif
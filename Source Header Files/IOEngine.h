@@ -2,8 +2,164 @@
 #define ___IOENGINE___H___
 
 #include "MemoryModel.h"
+#include "ListEngine.h"
 class IOEngine {
+private:
+    // Stores a string the engine built into return_address without copying it again.
+    static void pm_storeString(SectionMemory& current_memory, const str& return_address, str&& text) {
+        if (str* slot = current_memory.m_findTyped<str>(return_address))
+            *slot = std::move(text);
+        else
+            current_memory.m_reInsertVariable(return_address, { std::move(text), ENUM_TYPE_STRING });
+    }
+
+    // The whole input of the memory's source, read in large blocks.
+    static str pm_readSource(SectionMemory& current_memory) {
+        constexpr size_t block = 1 << 20;
+        InputSource& source = current_memory.m_input();
+        str text;
+        for (;;) {
+            size_t used = text.size();
+            text.resize(used + block);
+            size_t got = source.read(text.data() + used, block);
+            text.resize(used + got);
+            if (got == 0)
+                return text;
+        }
+    }
+
+    // Takes an optional "path" parameter: the file to read instead of the input source.
+    static bool pm_optionalPath(const std::vector<str>& parameters, SectionMemory& current_memory,
+        const char* function_name, str& path) {
+        if (parameters.empty())
+            return false;
+        if (parameters.size() > 1)
+            throw std::runtime_error(str(function_name) + "() takes at most one parameter! Syntax: () or (\"path\")");
+        value_t item = ListEngine::parseItem(parameters[0], current_memory, function_name);
+        if (item.second != ENUM_TYPE_STRING)
+            throw std::runtime_error(str("The path for ") + function_name + "() must be a string!");
+        path = std::move(std::get<str>(item.first));
+        return true;
+    }
+
+    // The slots of a print_fmt instruction, see formatUtility().
+    enum FormatSlot : uint8_t {
+        SLOT_LITERAL, SLOT_ANY, SLOT_I8, SLOT_I16, SLOT_I32, SLOT_I64,
+        SLOT_F32, SLOT_F64, SLOT_FMAX, SLOT_BOOL, SLOT_CHAR, SLOT_STRING
+    };
+
+    static FormatSlot pm_slotOf(std::string_view code) {
+        static const std::pair<std::string_view, FormatSlot> slots[] = {
+            {"c", SLOT_LITERAL}, {"v", SLOT_ANY}, {"i8", SLOT_I8}, {"i16", SLOT_I16},
+            {"i32", SLOT_I32}, {"i64", SLOT_I64}, {"f32", SLOT_F32}, {"f64", SLOT_F64},
+            {"fmax", SLOT_FMAX}, {"bool", SLOT_BOOL}, {"char", SLOT_CHAR}, {"str", SLOT_STRING}
+        };
+        for (const auto& slot : slots)
+            if (slot.first == code)
+                return slot.second;
+        throw std::runtime_error("Unknown slot '" + str(code) + "' in a print_fmt instruction!");
+    }
+
+    // A variable the compiler expected to have type T. If it has been re-typed since, the
+    // generic path formats it instead.
+    template <typename T>
+    static void pm_appendSlot(str& out, SectionMemory& current_memory, const str& name) {
+        const T* value = current_memory.m_findTyped<T>(name);
+        if (!value)
+            current_memory.m_appendStringalizedValue(out, name);
+        else if constexpr (std::is_same_v<T, bool>)
+            out += *value ? "true" : "false";
+        else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, str>)
+            out += *value;
+        else
+            NumberConversion::append(out, *value);
+    }
+
 public:
+    // Resolves a print_fmt_<slots> opcode written by the compiler to a kernel that appends the
+    // prepared literals and variables straight into the output buffer. Returns an empty
+    // function if the opcode isn't one.
+    static std::function<void(const std::vector<str>&, const str&, SectionMemory&)> formatUtility(const str& opcode) {
+        static const str prefix = "print_fmt";
+        if (opcode.rfind(prefix, 0) != 0)
+            return {};
+        std::vector<FormatSlot> slots;
+        for (size_t at = prefix.size(); at < opcode.size();) {
+            if (opcode[at] != '_')
+                return {};
+            size_t next = std::min(opcode.find('_', at + 1), opcode.size());
+            slots.push_back(pm_slotOf(std::string_view(opcode).substr(at + 1, next - at - 1)));
+            at = next;
+        }
+
+        return [slots = std::move(slots)](const std::vector<str>& parameters, const str&, SectionMemory& current_memory) {
+            if (parameters.size() != slots.size())
+                throw std::runtime_error("print_fmt has a different number of parameters than slots!");
+            OutputBuffer& output = current_memory.m_output();
+            str& out = output.text();
+            const size_t mark = out.size();
+            try {
+                for (size_t idx = 0; idx < slots.size(); ++idx) {
+                    const str& item = parameters[idx];
+                    switch (slots[idx]) {
+                    case SLOT_LITERAL: out += item; break;
+                    case SLOT_ANY: current_memory.m_appendStringalizedValue(out, item); break;
+                    case SLOT_I8: pm_appendSlot<int8_t>(out, current_memory, item); break;
+                    case SLOT_I16: pm_appendSlot<int16_t>(out, current_memory, item); break;
+                    case SLOT_I32: pm_appendSlot<int32_t>(out, current_memory, item); break;
+                    case SLOT_I64: pm_appendSlot<int64_t>(out, current_memory, item); break;
+                    case SLOT_F32: pm_appendSlot<float>(out, current_memory, item); break;
+                    case SLOT_F64: pm_appendSlot<double>(out, current_memory, item); break;
+                    case SLOT_FMAX: pm_appendSlot<long double>(out, current_memory, item); break;
+                    case SLOT_BOOL: pm_appendSlot<bool>(out, current_memory, item); break;
+                    case SLOT_CHAR: pm_appendSlot<char>(out, current_memory, item); break;
+                    case SLOT_STRING: pm_appendSlot<str>(out, current_memory, item); break;
+                    }
+                }
+            }
+            catch (...) {
+                out.resize(mark);
+                throw;
+            }
+            output.commit();
+        };
+    }
+
+    // Formats the items the way @print does, appending to out. If a variable is missing half
+    // way through, the partial text is taken back out before the error propagates. Also used
+    // by the string engine.
+    static void appendItems(str& out, std::span<const str> parameters, SectionMemory& current_memory, bool newLines) {
+        const size_t mark = out.size();
+        try {
+            for (const auto& item : parameters)
+            {
+                if (item.front() == '$')
+                {
+                    current_memory.m_appendStringalizedValue(out, item.substr(1));
+                }
+                else if (item.size() >= 2 && item.front() == '"' && item.back() == '"')
+                {
+                    out.append(item, 1, item.size() - 2);
+                }
+                else
+                {
+                    out += item;
+                }
+                if (newLines)
+                    out += '\n';
+            }
+        }
+        catch (...) {
+            out.resize(mark);
+            throw;
+        }
+    }
+    // appendItems() straight into the output buffer. Also used by the file engine.
+    static void writeItems(OutputBuffer& output, std::span<const str> parameters, SectionMemory& current_memory, bool newLines) {
+        appendItems(output.text(), parameters, current_memory, newLines);
+        output.commit();
+    }
+
     static void print
     (
         const std::vector<str>& parameters,
@@ -16,21 +172,7 @@ public:
             throw std::runtime_error(
                 "Return Address '" + return_address + "' was not found in the memory!"
             );
-        for (auto item : parameters)
-        {
-            if (item.front() == '$')
-            {
-                std::cout << current_memory.m_fetchStringalizedValue(item);
-            }
-            else if (item.size() >= 2 && item.front() == '"' && item.back() == '"')
-            {
-                std::cout << item.substr(1, item.size() - 2);
-            }
-            else
-            {
-                std::cout << item;
-            }
-        }
+        writeItems(current_memory.m_output(), parameters, current_memory, false);
     }
     static void println
     (
@@ -44,21 +186,7 @@ public:
             throw std::runtime_error(
                 "Return Address '" + return_address + "' was not found in the memory!"
             );
-        for (auto item : parameters)
-        {
-            if (item.front() == '$')
-            {
-                std::cout << current_memory.m_fetchStringalizedValue(item) << '\n';
-            }
-            else if (item.size() >= 2 && item.front() == '"' && item.back() == '"')
-            {
-                std::cout << item.substr(1, item.size() - 2) << '\n';
-            }
-            else
-            {
-                std::cout << item << '\n';
-            }
-        }
+        writeItems(current_memory.m_output(), parameters, current_memory, true);
     }
     static void flush
     (
@@ -76,7 +204,7 @@ public:
         }
         if (!parameters.empty())
             throw std::runtime_error("Error! flush() doesn't take any parameters.");
-        std::cout << std::flush;
+        current_memory.m_output().flush();
     }
     static void input
     (
@@ -97,14 +225,81 @@ public:
             display = current_memory.m_fetchStringalizedValue(display);
         if (display.front() == '"' && display.back() == '"')
             display = display.substr(1, display.size() - 2);
-        std::cout << display << std::flush;
+        // Only someone at a terminal needs to see the prompt before the read.
+        OutputBuffer& output = current_memory.m_output();
+        output.text() += display;
+        if (output.isLineBuffered())
+            output.flush();
+        else
+            output.commit();
         str inpStr;
-        std::getline(std::cin, inpStr);
+        current_memory.m_input().readLine(inpStr);
         if (return_address != "nullptr")
-        {
-            value_t value = { inpStr, ENUM_TYPE_STRING };
-            current_memory.m_reInsertVariable(return_address, value);
+            pm_storeString(current_memory, return_address, std::move(inpStr));
+    }
+    // read_lines : () ~ xs or read_lines : ("path") ~ xs. Reads the input source (or the file)
+    // to its end in one go and splits it into a list of strings, one per line, without the
+    // line endings. Files are mapped and split in place.
+    static void read_lines
+    (
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    )
+    {
+        if (return_address == "nullptr")
+            throw std::runtime_error("read_lines() needs a list to return into! Syntax: () ~ list_name");
+        str path;
+        std::shared_ptr<const MappedFile> file;
+        str text;
+        std::string_view input;
+        if (pm_optionalPath(parameters, current_memory, "read_lines", path)) {
+            file = MappedFile::open(path);
+            input = std::string_view(file->data(), file->size());
+        }
+        else {
+            text = pm_readSource(current_memory);
+            input = text;
         }
+
+        std::vector<value_t> lines;
+        lines.reserve(static_cast<size_t>(std::count(input.begin(), input.end(), '\n')) + 1);
+        while (!input.empty()) {
+            const void* newline = std::memchr(input.data(), '\n', input.size());
+            size_t length = newline ? static_cast<const char*>(newline) - input.data() : input.size();
+            std::string_view line = input.substr(0, length);
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            lines.emplace_back(str(line), ENUM_TYPE_STRING);
+            input.remove_prefix(newline ? length + 1 : length);
+        }
+        ListEngine::storeList(current_memory, return_address, ListValue(std::move(lines)));
+    }
+    // read_all : () ~ s or read_all : ("path") ~ s. Reads the input source (or the file) to
+    // its end into the string s.
+    static void read_all
+    (
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    )
+    {
+        if (!current_memory.m_containsVariable(return_address) &&
+            return_address != "nullptr")
+            throw std::runtime_error(
+                "Return Address '" + return_address + "' was not found in the memory!"
+            );
+        str path;
+        str text;
+        if (pm_optionalPath(parameters, current_memory, "read_all", path)) {
+            std::shared_ptr<const MappedFile> file = MappedFile::open(path);
+            text.assign(file->data(), file->size());
+        }
+        else {
+            text = pm_readSource(current_memory);
+        }
+        if (return_address != "nullptr")
+            pm_storeString(current_memory, return_address, std::move(text));
     }
 };
 
@@ -0,0 +1,200 @@
+#ifndef ___IO___SINKS___H___
+#define ___IO___SINKS___H___
+
+#include "includes.h"
+#if defined(_WIN32)
+#    include <io.h>
+#else
+#    include <cerrno>
+#    include <unistd.h>
+#endif
+
+// Where a VM's output ends up. OutputBuffer batches the program's output and hands it
+// over in large pieces, so write() is called rarely and may be slow.
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+
+    virtual void write(std::string_view bytes) = 0;
+    virtual void flush() {}
+
+    // True if a person is probably watching; OutputBuffer then defaults to line buffering.
+    virtual bool interactive() const { return false; }
+
+    // A sink that simply collects everything may return its string here, and OutputBuffer
+    // will then format straight into it instead of copying through its own buffer.
+    virtual std::string* storage() { return nullptr; }
+};
+
+// Writes to a file descriptor with write(2). The descriptor is not closed.
+class FdSink : public OutputSink {
+private:
+    int descriptor;
+
+public:
+    explicit FdSink(int fd) : descriptor(fd) {}
+
+    void write(std::string_view bytes) override {
+        size_t done = 0;
+        while (done < bytes.size()) {
+#if defined(_WIN32)
+            int written = ::_write(descriptor, bytes.data() + done,
+                static_cast<unsigned>(std::min<size_t>(bytes.size() - done, INT_MAX)));
+#else
+            ssize_t written = ::write(descriptor, bytes.data() + done, bytes.size() - done);
+            if (written < 0 && errno == EINTR)
+                continue;
+#endif
+            if (written <= 0)
+                throw std::runtime_error("Couldn't write the program output!");
+            done += static_cast<size_t>(written);
+        }
+    }
+
+    bool interactive() const override {
+#if defined(_WIN32)
+        return ::_isatty(descriptor) != 0;
+#else
+        return ::isatty(descriptor) != 0;
+#endif
+    }
+};
+
+// Keeps all output in memory. After execute() the host reads it with view(), without a copy.
+class MemorySink : public OutputSink {
+private:
+    std::string collected;
+
+public:
+    void write(std::string_view bytes) override { collected.append(bytes); }
+    std::string* storage() override { return &collected; }
+
+    std::string_view view() const { return collected; }
+    void clear() { collected.clear(); }
+};
+
+// Passes every batch of output to a host callback.
+class CallbackSink : public OutputSink {
+private:
+    std::function<void(std::string_view)> callback;
+
+public:
+    explicit CallbackSink(std::function<void(std::string_view)> fn) : callback(std::move(fn)) {}
+
+    void write(std::string_view bytes) override { callback(bytes); }
+};
+
+// Where @input reads from. Implementations only have to provide fill(); lines are cut
+// out of what it returns. Sources that have a better way to read a line override readLine().
+class InputSource {
+private:
+    std::string pending;
+    size_t consumed = 0;
+
+protected:
+    // Reads up to capacity bytes into `into`, returning 0 only at the end of the input.
+    virtual size_t fill(char* into, size_t capacity) = 0;
+
+public:
+    virtual ~InputSource() = default;
+
+    // Reads one line without its line ending. Returns false if the input had already ended.
+    virtual bool readLine(std::string& line) {
+        line.clear();
+        for (;;) {
+            const char* begin = pending.data() + consumed;
+            const void* newline = std::memchr(begin, '\n', pending.size() - consumed);
+            if (newline) {
+                size_t length = static_cast<const char*>(newline) - begin;
+                line.append(begin, length);
+                consumed += length + 1;
+                break;
+            }
+            line.append(begin, pending.size() - consumed);
+            pending.resize(1 << 12);
+            consumed = 0;
+            size_t got = fill(pending.data(), pending.size());
+            pending.resize(got);
+            if (got == 0)
+                return !line.empty();
+        }
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        return true;
+    }
+
+    // Reads up to capacity bytes, starting with whatever readLine() had already buffered.
+    size_t read(char* into, size_t capacity) {
+        if (consumed < pending.size()) {
+            size_t count = std::min(capacity, pending.size() - consumed);
+            std::memcpy(into, pending.data() + consumed, count);
+            consumed += count;
+            return count;
+        }
+        return fill(into, capacity);
+    }
+};
+
+// Reads from a std::istream; the default source of a VM is std::cin.
+class StreamSource : public InputSource {
+private:
+    std::istream& in;
+
+protected:
+    size_t fill(char* into, size_t capacity) override {
+        in.read(into, static_cast<std::streamsize>(capacity));
+        return static_cast<size_t>(in.gcount());
+    }
+
+public:
+    explicit StreamSource(std::istream& stream) : in(stream) {}
+
+    bool readLine(std::string& line) override {
+        return static_cast<bool>(std::getline(in, line));
+    }
+};
+
+// Reads from a file descriptor with read(2). The descriptor is not closed.
+class FdSource : public InputSource {
+private:
+    int descriptor;
+
+protected:
+    size_t fill(char* into, size_t capacity) override {
+        for (;;) {
+#if defined(_WIN32)
+            int got = ::_read(descriptor, into,
+                static_cast<unsigned>(std::min<size_t>(capacity, INT_MAX)));
+#else
+            ssize_t got = ::read(descriptor, into, capacity);
+            if (got < 0 && errno == EINTR)
+                continue;
+#endif
+            if (got < 0)
+                throw std::runtime_error("Couldn't read the program input!");
+            return static_cast<size_t>(got);
+        }
+    }
+
+public:
+    explicit FdSource(int fd) : descriptor(fd) {}
+};
+
+// Serves input from a string the host already has.
+class MemorySource : public InputSource {
+private:
+    std::string text;
+    size_t position = 0;
+
+protected:
+    size_t fill(char* into, size_t capacity) override {
+        size_t count = std::min(capacity, text.size() - position);
+        std::memcpy(into, text.data() + position, count);
+        position += count;
+        return count;
+    }
+
+public:
+    explicit MemorySource(std::string input) : text(std::move(input)) {}
+};
+#endif
@@ -3,6 +3,7 @@
 
 #include "MemoryModel.h"
 #include "DeclaratorEngine.h"
+#include "MappedFile.h"
 class ListEngine {
     static std::vector<str> splitContents(const str& bracket_bounded_contents) {
         std::vector<str> contents;          
@@ -120,6 +121,504 @@ class ListEngine {
         return inner.size() == 1;
     }
 
+    // Reads (name, start, stop, step[, type]) and calls fn(T{}, first, step, count) with the
+    // range's bounds in the wide type of T. Like @loop, stop itself is included when it is hit.
+    template <typename Fn>
+    static void pm_withRange(const std::vector<str>& parameters, SectionMemory& current_memory, const char* function_name, Fn&& fn) {
+        if (parameters.size() != 4 && parameters.size() != 5)
+            throw std::runtime_error(str(function_name) + "() requires four or five parameters! Syntax: (list_name, start, stop, step[, type])");
+        str type = parameters.size() == 5 ? parameters[4] : "i64";
+        if (type == "dynamic")
+            throw std::runtime_error(str(function_name) + "() builds typed lists only!");
+
+        value_t start = parseItem(parameters[1], current_memory, function_name);
+        value_t stop = parseItem(parameters[2], current_memory, function_name);
+        value_t step = parseItem(parameters[3], current_memory, function_name);
+
+        ListValue::m_ofType(type).m_visit([&](auto& values) {
+            using T = typename std::decay_t<decltype(values)>::value_type;
+            if constexpr (std::is_floating_point_v<T>) {
+                // Literals are read at full precision; parseItem() would narrow them to f32 when they fit.
+                auto bound = [&](size_t idx, const value_t& parsed) {
+                    const str& token = parameters[idx];
+                    return token.front() == '$' ? ListValue::m_toElement<double>(parsed) : NumberConversion::parse<double>(token);
+                };
+                double first = bound(1, start);
+                double last = bound(2, stop);
+                double delta = bound(3, step);
+                double steps = (last - first) / delta;
+                if (delta == 0 || !std::isfinite(steps))
+                    throw std::runtime_error(str("Bad bounds or step for ") + function_name + "()");
+                // Tolerate rounding so that e.g. 0 to 0.3 by 0.1 includes 0.3.
+                steps += std::fabs(steps) * 1e-12;
+                if (steps >= 0x1p53)
+                    throw std::runtime_error(str("Too many elements requested in ") + function_name + "()");
+                size_t count = steps < 0 ? 0 : static_cast<size_t>(steps) + 1;
+                ListValue::m_toElement<T>({ first, ENUM_TYPE_F64 });
+                fn(T{}, first, delta, count);
+            }
+            else if constexpr (std::is_integral_v<T>) {
+                for (const value_t* bound : { &start, &stop, &step })
+                    if (bound->second == ENUM_TYPE_F32 || bound->second == ENUM_TYPE_F64 || bound->second == ENUM_TYPE_FMAX)
+                        throw std::runtime_error(str("Integer lists need integer bounds and step in ") + function_name + "()");
+                int64_t first = ListValue::m_toElement<int64_t>(start);
+                int64_t last = ListValue::m_toElement<int64_t>(stop);
+                int64_t delta = ListValue::m_toElement<int64_t>(step);
+                if (delta == 0)
+                    throw std::runtime_error(str("Step for ") + function_name + "() can't be zero!");
+
+                uint64_t span = 0, stride = 0;
+                bool empty = delta > 0 ? last < first : last > first;
+                if (delta > 0) { span = static_cast<uint64_t>(last) - static_cast<uint64_t>(first); stride = static_cast<uint64_t>(delta); }
+                else { span = static_cast<uint64_t>(first) - static_cast<uint64_t>(last); stride = 0 - static_cast<uint64_t>(delta); }
+                if (!empty && span / stride == UINT64_MAX)
+                    throw std::runtime_error(str("Too many elements requested in ") + function_name + "()");
+                size_t count = empty ? 0 : static_cast<size_t>(span / stride + 1);
+                if (count) {
+                    // Elements lie between the first and the last one, so checking both ends is enough.
+                    int64_t final_element = static_cast<int64_t>(static_cast<uint64_t>(first) + (count - 1) * static_cast<uint64_t>(delta));
+                    ListValue::m_toElement<T>({ first, ENUM_TYPE_I64 });
+                    ListValue::m_toElement<T>({ final_element, ENUM_TYPE_I64 });
+                }
+                fn(T{}, first, delta, count);
+            }
+            });
+    }
+
+    // Binary list files: a 16 byte header ("VLST", format version, element type code, two zero
+    // bytes, element count as a little-endian u64) followed by the raw little-endian elements.
+    // The header keeps the elements 16-byte aligned inside a mapped file.
+    static constexpr size_t pm_binaryHeaderSize = 16;
+    static constexpr uint8_t pm_binaryVersion = 1;
+
+    static uint8_t pm_binaryTypeCode(const str& type) {
+        static const std::vector<str> codes = { "i8", "i16", "i32", "i64", "f32", "f64" };
+        auto found = std::find(codes.begin(), codes.end(), type);
+        if (found == codes.end())
+            throw std::runtime_error("Only typed lists (i8, i16, i32, i64, f32, f64) can be stored in binary files!");
+        return static_cast<uint8_t>(found - codes.begin() + 1);
+    }
+    template <typename T>
+    static T pm_byteswap(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        std::reverse(bytes, bytes + sizeof(T));
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+    static str pm_readPath(const str& token, SectionMemory& current_memory, const char* function_name) {
+        value_t path = parseItem(token, current_memory, function_name);
+        if (path.second != ENUM_TYPE_STRING)
+            throw std::runtime_error(str("The path for ") + function_name + "() must be a string!");
+        return std::get<str>(path.first);
+    }
+
+public:
+    // Binds a list to listName, replacing any list already there.
+    static void storeList(SectionMemory& current_memory, const str& listName, ListValue&& list) {
+        if (ListValue* existing = current_memory.m_findList(listName))
+            *existing = std::move(list);
+        else
+            current_memory.m_insertList(listName, std::move(list));
+    }
+    // Parses a literal or a $variable into a typed value. Also used by the dictionary engine.
+    static value_t parseItem(const str& item, SectionMemory& current_memory, const char* function_name) {
+        if (item.empty()) {
+            throw std::runtime_error(str("Bad value for ") + function_name + "()");
+        }
+        if (item.front() == '$') {
+            str var_name = item.substr(1);
+            if (!current_memory.m_containsVariable(var_name)) {
+                throw std::runtime_error("Can't find the variable! (" + var_name + ")");
+            }
+            return current_memory.m_getVariable(var_name);
+        }
+        bool containsDot = false;
+        if (item == "true" || item == "false")
+            return { item == "true", ENUM_TYPE_BOOL };
+        if (isNum(item, containsDot)) {
+            if (!containsDot) {
+                int64_t num = 0;
+                if (NumberConversion::tryParse(item, num) != std::errc())
+                    throw std::runtime_error("Number is too big");
+                if (num >= INT8_MIN && num <= INT8_MAX)
+                    return { static_cast<int8_t>(num), ENUM_TYPE_I8 };
+                if (num >= INT16_MIN && num <= INT16_MAX)
+                    return { static_cast<int16_t>(num), ENUM_TYPE_I16 };
+                if (num >= INT32_MIN && num <= INT32_MAX)
+                    return { static_cast<int32_t>(num), ENUM_TYPE_I32 };
+                return { num, ENUM_TYPE_I64 };
+            }
+            long double num = NumberConversion::parse<long double>(item);
+            if (std::fabs(num) <= FLT_MAX)
+                return { static_cast<float>(num), ENUM_TYPE_F32 };
+            if (std::fabs(num) <= DBL_MAX)
+                return { static_cast<double>(num), ENUM_TYPE_F64 };
+            return { num, ENUM_TYPE_FMAX };
+        }
+        if (___isChar___(item))
+            return { DeclaratorEngine::decodeChar(item.substr(1, item.size() - 2), item), ENUM_TYPE_CHAR };
+        if (item.size() >= 2 && item.front() == '"' && item.back() == '"')
+            return { item.substr(1, item.size() - 2), ENUM_TYPE_STRING };
+
+        throw std::runtime_error(str("Bad value for ") + function_name + "() (" + item + ")");
+    }
+private:
+    // Appends one literal or $variable to the list. Typed lists parse literals straight into their element type.
+    static void pm_pushItem(ListValue& list, const str& item, SectionMemory& current_memory, const char* function_name) {
+        list.m_visit([&](auto& values) {
+            using T = typename std::decay_t<decltype(values)>::value_type;
+            if constexpr (std::is_same_v<T, value_t>) {
+                values.push_back(parseItem(item, current_memory, function_name));
+            }
+            else if (!item.empty() && item.front() != '$') {
+                T element{};
+                if (NumberConversion::tryParse(item, element) != std::errc()) {
+                    throw std::runtime_error(str("Only numbers that fit the element type can be stored in a typed list, in ") + function_name + "() (" + item + ")");
+                }
+                values.push_back(element);
+            }
+            else {
+                values.push_back(ListValue::m_toElement<T>(parseItem(item, current_memory, function_name)));
+            }
+            });
+    }
+    static ListValue pm_parseList(
+        const str& type,
+        const str& bracket_bounded_contents,
+        SectionMemory& current_memory,
+        const char* function_name
+    ) {
+        ListValue list = ListValue::m_ofType(type);
+        std::vector<str> contents = splitContents(bracket_bounded_contents);
+        list.m_reserve(contents.size());
+        for (const auto& item : contents)
+            pm_pushItem(list, item, current_memory, function_name);
+        return list;
+    }
+
+    // Bulk operations work on packed storage. A dynamic list is packed on the fly into
+    // i64 when every element is an integer and into f64 otherwise.
+    static ListValue pm_packDynamic(const ListValue& list, const char* function_name) {
+        return list.m_visit([function_name](auto values) {
+            using T = typename decltype(values)::value_type;
+            if constexpr (std::is_same_v<T, value_t>)
+                return pm_packValues(values, function_name);
+            else
+                return ListValue(std::vector<T>(values.begin(), values.end()));
+            });
+    }
+    static ListValue pm_packValues(std::span<const value_t> values, const char* function_name) {
+        bool integers = true;
+        for (const auto& value : values) {
+            switch (value.second) {
+            case ENUM_TYPE_I8: case ENUM_TYPE_I16: case ENUM_TYPE_I32: case ENUM_TYPE_I64:
+                break;
+            case ENUM_TYPE_F32: case ENUM_TYPE_F64: case ENUM_TYPE_FMAX:
+                integers = false;
+                break;
+            default:
+                throw std::runtime_error(str("Only numeric lists are accepted by ") + function_name + "()");
+            }
+        }
+        if (integers) {
+            std::vector<int64_t> packed(values.size());
+            for (size_t idx = 0; idx < values.size(); ++idx)
+                packed[idx] = ListValue::m_toElement<int64_t>(values[idx]);
+            return ListValue(std::move(packed));
+        }
+        std::vector<double> packed(values.size());
+        for (size_t idx = 0; idx < values.size(); ++idx)
+            packed[idx] = ListValue::m_toElement<double>(values[idx]);
+        return ListValue(std::move(packed));
+    }
+    static const ListValue& pm_numeric(const ListValue& list, ListValue& scratch, const char* function_name) {
+        if (list.m_isPacked())
+            return list;
+        scratch = pm_packDynamic(list, function_name);
+        return scratch;
+    }
+
+    template <typename T>
+    static std::vector<T> pm_convert(const ListValue& list) {
+        return list.m_visit([](const auto& values) {
+            using V = typename std::decay_t<decltype(values)>::value_type;
+            std::vector<T> result(values.size());
+            if constexpr (std::is_same_v<V, value_t>) {
+                for (size_t idx = 0; idx < values.size(); ++idx)
+                    result[idx] = ListValue::m_toElement<T>(values[idx]);
+            }
+            else {
+                for (size_t idx = 0; idx < values.size(); ++idx)
+                    result[idx] = static_cast<T>(values[idx]);
+            }
+            return result;
+            });
+    }
+
+    // Result element type of an operation between two element types: the wider integer, or
+    // a float wide enough for both sides.
+    static str pm_commonType(const str& left, const str& right) {
+        static const std::vector<str> order = { "i8", "i16", "i32", "i64", "f32", "f64" };
+        size_t l = std::find(order.begin(), order.end(), left) - order.begin();
+        size_t r = std::find(order.begin(), order.end(), right) - order.begin();
+        if (l >= 4 || r >= 4) {
+            if (l == 5 || r == 5 || l == 2 || r == 2 || l == 3 || r == 3)
+                return "f64";
+            return "f32";
+        }
+        return order[std::max(l, r)];
+    }
+    static str pm_scalarType(const value_t& value) {
+        switch (value.second) {
+        case ENUM_TYPE_I8: return "i8";
+        case ENUM_TYPE_I16: return "i16";
+        case ENUM_TYPE_I32: return "i32";
+        case ENUM_TYPE_I64: return "i64";
+        case ENUM_TYPE_F32: return "f32";
+        case ENUM_TYPE_F64:
+        case ENUM_TYPE_FMAX: return "f64";
+        default: throw std::runtime_error("list_scale() needs a numeric factor!");
+        }
+    }
+
+    // Elementwise a[i] (+|*) rhs(i). Written as flat loops over native arrays so the compiler can
+    // vectorize them; integer overflow is collected into a flag instead of branching per element.
+    template <typename T, typename Rhs>
+    static std::vector<T> pm_combine(std::vector<T> a, Rhs rhs, bool multiply, const char* function_name) {
+        bool overflow = false;
+        if constexpr (std::is_floating_point_v<T>) {
+            if (multiply) for (size_t idx = 0; idx < a.size(); ++idx) a[idx] *= rhs(idx);
+            else for (size_t idx = 0; idx < a.size(); ++idx) a[idx] += rhs(idx);
+        }
+        else if constexpr (sizeof(T) < sizeof(int64_t)) {
+            for (size_t idx = 0; idx < a.size(); ++idx) {
+                int64_t result = multiply ? int64_t(a[idx]) * int64_t(rhs(idx)) : int64_t(a[idx]) + int64_t(rhs(idx));
+                overflow |= result < std::numeric_limits<T>::lowest() || result > std::numeric_limits<T>::max();
+                a[idx] = static_cast<T>(result);
+            }
+        }
+        else if (multiply) {
+            for (size_t idx = 0; idx < a.size(); ++idx) {
+                int64_t left = a[idx], right = rhs(idx);
+                int64_t result = static_cast<int64_t>(static_cast<uint64_t>(left) * static_cast<uint64_t>(right));
+                overflow |= left != 0 && ((left == -1 && right == INT64_MIN) || (left != -1 && result / left != right));
+                a[idx] = result;
+            }
+        }
+        else {
+            for (size_t idx = 0; idx < a.size(); ++idx) {
+                int64_t left = a[idx], right = rhs(idx);
+                int64_t result = static_cast<int64_t>(static_cast<uint64_t>(left) + static_cast<uint64_t>(right));
+                overflow |= ((left ^ result) & (right ^ result)) < 0;
+                a[idx] = result;
+            }
+        }
+        if (overflow)
+            throw std::runtime_error(str("Overflow in ") + function_name + "(): result doesn't fit in the list type");
+        return a;
+    }
+
+    template <typename Fn>
+    static decltype(auto) pm_withType(const str& type, Fn&& fn) {
+        if (type == "i8") return fn(int8_t{});
+        if (type == "i16") return fn(int16_t{});
+        if (type == "i32") return fn(int32_t{});
+        if (type == "i64") return fn(int64_t{});
+        if (type == "f32") return fn(float{});
+        return fn(double{});
+    }
+
+    static void pm_elementwise(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory,
+        bool multiply,
+        const char* function_name
+    ) {
+        if (parameters.size() != 2)
+            throw std::runtime_error(str(function_name) + "() requires two lists! Syntax: (xs, ys) ~ result_list");
+        ListValue left_scratch, right_scratch;
+        const ListValue& left = pm_numeric(current_memory.m_getList(parameters[0]), left_scratch, function_name);
+        const ListValue& right = pm_numeric(current_memory.m_getList(parameters[1]), right_scratch, function_name);
+        if (left.m_size() != right.m_size())
+            throw std::runtime_error(str("Lists passed to ") + function_name + "() must have the same size!");
+
+        ListValue result = pm_withType(pm_commonType(left.m_typeName(), right.m_typeName()), [&](auto tag) {
+            using T = decltype(tag);
+            std::vector<T> rhs = pm_convert<T>(right);
+            return ListValue(pm_combine<T>(pm_convert<T>(left), [&rhs](size_t idx) { return rhs[idx]; }, multiply, function_name));
+            });
+        storeList(current_memory, return_address, std::move(result));
+    }
+
+    // Sums with several independent accumulators so floating point reductions vectorize
+    // without relying on -ffast-math reassociation.
+    template <typename D, typename T>
+    static D pm_sum(std::span<const T> values) {
+        constexpr size_t lanes = 8;
+        D partial[lanes] = {};
+        size_t idx = 0;
+        for (; idx + lanes <= values.size(); idx += lanes)
+            for (size_t lane = 0; lane < lanes; ++lane)
+                partial[lane] += static_cast<D>(values[idx + lane]);
+        D total = 0;
+        for (size_t lane = 0; lane < lanes; ++lane)
+            total += partial[lane];
+        for (; idx < values.size(); ++idx)
+            total += static_cast<D>(values[idx]);
+        return total;
+    }
+    template <typename D>
+    static D pm_dot(const std::vector<D>& left, const std::vector<D>& right) {
+        constexpr size_t lanes = 8;
+        D partial[lanes] = {};
+        size_t idx = 0;
+        for (; idx + lanes <= left.size(); idx += lanes)
+            for (size_t lane = 0; lane < lanes; ++lane)
+                partial[lane] += left[idx + lane] * right[idx + lane];
+        D total = 0;
+        for (size_t lane = 0; lane < lanes; ++lane)
+            total += partial[lane];
+        for (; idx < left.size(); ++idx)
+            total += left[idx] * right[idx];
+        return total;
+    }
+    static int64_t pm_checkedSum(std::span<const int64_t> values) {
+        int64_t total = 0;
+        bool overflow = false;
+        for (int64_t value : values) {
+            int64_t result = static_cast<int64_t>(static_cast<uint64_t>(total) + static_cast<uint64_t>(value));
+            overflow |= ((total ^ result) & (value ^ result)) < 0;
+            total = result;
+        }
+        if (overflow)
+            throw std::runtime_error("Overflow in list_sum(): result doesn't fit in i64");
+        return total;
+    }
+
+    static void pm_extreme(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory,
+        bool maximum,
+        const char* function_name
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error(str(function_name) + "() requires exactly one parameter!");
+        if (!current_memory.m_containsVariable(return_address))
+            throw std::runtime_error(str("Couldn't find the return_address, in the function ") + function_name + "()!");
+        ListValue scratch;
+        const ListValue& list = pm_numeric(current_memory.m_getList(parameters[0]), scratch, function_name);
+        if (list.m_empty())
+            throw std::runtime_error(str(function_name) + "() of an empty list!");
+        size_t best = list.m_visit([maximum](const auto& values) -> size_t {
+            using T = typename std::decay_t<decltype(values)>::value_type;
+            if constexpr (std::is_same_v<T, value_t>) {
+                return 0;
+            }
+            else {
+                // NaN (e.g. an empty CSV cell) never wins; a list of nothing but NaN gives NaN.
+                size_t found = values.size();
+                for (size_t idx = 0; idx < values.size(); ++idx) {
+                    if constexpr (std::is_floating_point_v<T>)
+                        if (std::isnan(values[idx]))
+                            continue;
+                    if (found == values.size() ||
+                        (maximum ? values[idx] > values[found] : values[idx] < values[found]))
+                        found = idx;
+                }
+                return found == values.size() ? 0 : found;
+            }
+            });
+        current_memory.m_reInsertVariable(return_address, list.m_at(best));
+    }
+
+    static int64_t pm_resolveIndex(const str& token, SectionMemory& current_memory, const char* function_name) {
+        if (!token.empty() && token.front() == '$') {
+            str var_name = token.substr(1);
+            if (!current_memory.m_containsVariable(var_name))
+                throw std::runtime_error(str("Couldn't find the index variable in ") + function_name + "()");
+            return current_memory.m_fetchInteger(var_name);
+        }
+        int64_t idx = 0;
+        if (NumberConversion::tryParse(token, idx) != std::errc())
+            throw std::runtime_error(str("Index for ") + function_name + "() is not a valid integer");
+        return idx;
+    }
+
+    // Ordering used by sort(): NaN sorts after every number. Dynamic lists order booleans, then
+    // numbers (compared by value across types), then chars, then strings (lexicographically).
+    static int pm_rank(typeEnum type) {
+        switch (type) {
+        case ENUM_TYPE_BOOL: return 0;
+        case ENUM_TYPE_CHAR: return 2;
+        case ENUM_TYPE_STRING: return 3;
+        default: return 1;
+        }
+    }
+    template <typename T>
+    static bool pm_less(const T& left, const T& right) {
+        if constexpr (std::is_floating_point_v<T>)
+            return left < right || (!std::isnan(left) && std::isnan(right));
+        else if constexpr (std::is_same_v<T, value_t>) {
+            int left_rank = pm_rank(left.second), right_rank = pm_rank(right.second);
+            if (left_rank != right_rank)
+                return left_rank < right_rank;
+            switch (left_rank) {
+            case 0: return std::get<bool>(left.first) < std::get<bool>(right.first);
+            case 2: return std::get<char>(left.first) < std::get<char>(right.first);
+            case 3: return std::get<str>(left.first) < std::get<str>(right.first);
+            }
+            if (left.second == ENUM_TYPE_I64 && right.second == ENUM_TYPE_I64)
+                return std::get<int64_t>(left.first) < std::get<int64_t>(right.first);
+            return pm_less(ListValue::m_toElement<long double>(left), ListValue::m_toElement<long double>(right));
+        }
+        else
+            return left < right;
+    }
+
+    // Lists at least this long are sorted on several threads.
+    static constexpr size_t pm_parallelSortThreshold = 1 << 16;
+
+    // Sorts equal chunks concurrently, then merges neighbouring runs pairwise, also concurrently.
+    // Merging left run into right run keeps the result stable when the chunks were sorted stably.
+    template <typename T, typename Compare>
+    static void pm_sort(std::vector<T>& values, Compare less, bool stable) {
+        size_t workers = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+            values.size() / (pm_parallelSortThreshold / 4));
+        if (values.size() < pm_parallelSortThreshold || workers < 2) {
+            if (stable) std::stable_sort(values.begin(), values.end(), less);
+            else std::sort(values.begin(), values.end(), less);
+            return;
+        }
+
+        std::vector<size_t> bounds(workers + 1);
+        for (size_t chunk = 0; chunk <= workers; ++chunk)
+            bounds[chunk] = values.size() * chunk / workers;
+        auto at = [&values, &bounds](size_t chunk) { return values.begin() + bounds[std::min(chunk, bounds.size() - 1)]; };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers);
+        for (size_t chunk = 0; chunk < workers; ++chunk)
+            threads.emplace_back([&, chunk] {
+                if (stable) std::stable_sort(at(chunk), at(chunk + 1), less);
+                else std::sort(at(chunk), at(chunk + 1), less);
+                });
+        for (auto& thread : threads)
+            thread.join();
+
+        for (size_t width = 1; width < workers; width *= 2) {
+            threads.clear();
+            for (size_t chunk = 0; chunk + width < workers; chunk += 2 * width)
+                threads.emplace_back([&, chunk, width] {
+                    std::inplace_merge(at(chunk), at(chunk + width), at(chunk + 2 * width), less);
+                    });
+            for (auto& thread : threads)
+                thread.join();
+        }
+    }
+
 public:
     static void new_list(
         const std::vector<str>& parameters,
@@ -128,64 +627,13 @@ public:
     ) {
         if (parameters.size() != 3)
             throw std::runtime_error(
-                "Parameters take three parameters, syntax: (name, type: [anyBuiltIn, 'dynamic'], values: [iterable])"
+                "Parameters take three parameters, syntax: (name, type: [dynamic, i8, i16, i32, i64, f32, f64], values: [iterable])"
             );
-        std::vector<str> contents = splitContents(parameters[2]);
-        str listName = parameters[0];
-        str size_name = str("___LIST___ENGINE___") + listName + str("___SIZE___");
-        if (current_memory.m_containsVariable(size_name)) {
-            std::cout << "\n[ERROR_ENGINE] The listName that is causing the error: (" << listName << ")\n";
-            throw std::runtime_error("List already exsists!");
-        }
-        current_memory.m_insertVariable(size_name, { static_cast<int64_t>(contents.size()) , ENUM_TYPE_I64 });
-        if (parameters[1] == "dynamic") {
-            int it_count = 0; 
-            for (auto item : contents) {
-                bool containsDot = false;
-                str name = str("___LIST___ENGINE___") + listName + str("___") + std::to_string(it_count) + str("___");
-                if (item == "true" || item == "false") {
-                    current_memory.m_insertVariable(name, { item == "true", ENUM_TYPE_BOOL });
-                }
-                else if (isNum(item, containsDot)) {
-                    long double num = std::stold(item);
-                    if (!containsDot) {
-                        if (num >= -128 && num <= 127)
-                            current_memory.m_insertVariable(name, { static_cast<int8_t>(num), ENUM_TYPE_I8 });
-                        else if (num >= SHRT_MIN && num <= SHRT_MAX)
-                            current_memory.m_insertVariable(name, { static_cast<int16_t>(num), ENUM_TYPE_I16 });
-                        else if (num >= INT32_MIN && num <= INT32_MAX)
-                            current_memory.m_insertVariable(name, { static_cast<int32_t>(num), ENUM_TYPE_I32 });
-                        else if (num >= INT64_MIN && num <= INT64_MAX)
-                            current_memory.m_insertVariable(name, { static_cast<int64_t>(num), ENUM_TYPE_I64 });
-                        else
-                            throw std::runtime_error("Number is too big");
-                    }
-                    else {
-                        if (num >= FLT_MIN && num <= FLT_MAX)
-                            current_memory.m_insertVariable(name, { static_cast<float>(num), ENUM_TYPE_F32 });
-                        else if (num >= DBL_MIN && num <= DBL_MAX)
-                            current_memory.m_insertVariable(name, { static_cast<double>(num), ENUM_TYPE_F64 });
-                        else if (num >= LDBL_MIN && num <= LDBL_MAX)
-                            current_memory.m_insertVariable(name, { static_cast<long double>(num), ENUM_TYPE_FMAX });
-                        else
-                            throw std::runtime_error("Number is too big");
-                    }
-                }
-                else if (___isChar___(item)) {
-                    DeclaratorEngine::new_char({ name, item }, "nullptr", current_memory);
-                }
-                else if (item.front() == '"' && item.back() == '"') {
-                    item = item.substr(1, item.length() - 2); 
-                    current_memory.m_insertVariable(name, { item, ENUM_TYPE_STRING });
-                }
-                else {
-                    std::cerr << "\n[ERROR_ENGINE] The item causing exception: " << item << '\n';
-                    throw std::runtime_error("Bad value for reAssign_list");
-                }
-
-                it_count++; 
-            }
+        const str& listName = parameters[0];
+        if (current_memory.m_containsList(listName)) {
+            throw std::runtime_error("List already exsists! (" + listName + ")");
         }
+        current_memory.m_insertList(listName, pm_parseList(parameters[1], parameters[2], current_memory, "new_list"));
     }
     static void reAssign_list(
         const std::vector<str>& parameters,
@@ -194,94 +642,17 @@ public:
     ) {
         if (parameters.size() != 3)
             throw std::runtime_error(
-                "Parameters take three parameters, syntax: (name, type: [anyBuiltIn, 'dynamic'], values: [iterable])"
+                "Parameters take three parameters, syntax: (name, type: [dynamic, i8, i16, i32, i64, f32, f64], values: [iterable])"
             );
-
-        std::vector<str> contents = splitContents(parameters[2]);
-        str listName = parameters[0];
-        str size_name = str("___LIST___ENGINE___") + listName + str("___SIZE___");
-        if (!current_memory.m_containsVariable(size_name)) {
-        
-            std::cout << "\n[ERROR_ENGINE] The listName that is causing the error: (" << listName << ")\n";
-            throw std::runtime_error("Couldn't find the list!");
-        }
-        current_memory.m_reInsertVariable(size_name, { static_cast<int64_t>(contents.size()) , ENUM_TYPE_I64 });
-
-        if (parameters[1] == "dynamic") {
-            int it_count = 0;
-
-            for (auto item : contents) {
-                bool containsDot = false;
-                str name = str("___LIST___ENGINE___") + listName + str("___") + std::to_string(it_count) + str("___");
-
-                if (item == "true" || item == "false") {
-                    current_memory.m_reInsertVariable(name, { item == "true", ENUM_TYPE_BOOL });
-                }
-                else if (isNum(item, containsDot)) {
-                    long double num = std::stold(item);
-
-                    if (!containsDot) {
-                        if (num >= -128 && num <= 127)
-                            current_memory.m_reInsertVariable(name, { static_cast<int8_t>(num), ENUM_TYPE_I8 });
-                        else if (num >= SHRT_MIN && num <= SHRT_MAX)
-                            current_memory.m_reInsertVariable(name, { static_cast<int16_t>(num), ENUM_TYPE_I16 });
-                        else if (num >= INT32_MIN && num <= INT32_MAX)
-                            current_memory.m_reInsertVariable(name, { static_cast<int32_t>(num), ENUM_TYPE_I32 });
-                        else if (num >= INT64_MIN && num <= INT64_MAX)
-                            current_memory.m_reInsertVariable(name, { static_cast<int64_t>(num), ENUM_TYPE_I64 });
-                        else
-                            throw std::runtime_error("Number is too big");
-                    }
-                    else {
-                        if (num >= FLT_MIN && num <= FLT_MAX)
-                            current_memory.m_reInsertVariable(name, { static_cast<float>(num), ENUM_TYPE_F32 });
-                        else if (num >= DBL_MIN && num <= DBL_MAX)
-                            current_memory.m_reInsertVariable(name, { static_cast<double>(num), ENUM_TYPE_F64 });
-                        else if (num >= LDBL_MIN && num <= LDBL_MAX)
-                            current_memory.m_reInsertVariable(name, { static_cast<long double>(num), ENUM_TYPE_FMAX });
-                        else
-                            throw std::runtime_error("Number is too big");
-                    }
-                }
-                else if (___isChar___(item)) {
-                    DeclaratorEngine::reAssign_char({ name, item }, "nullptr", current_memory);
-                }
-                else if (item.front() == '"' && item.back() == '"') {
-                    item = item.substr(1, item.length() - 2);
-                    current_memory.m_reInsertVariable(name, { item, ENUM_TYPE_STRING });
-                }
-                else {
-                    std::cerr << "\n[ERROR_ENGINE] The item causing exception: " << item << '\n';
-                    throw std::runtime_error("Bad value for reAssign_list");
-                }
-
-                it_count++;
-            }
-        }
+        current_memory.m_getList(parameters[0]) = pm_parseList(parameters[1], parameters[2], current_memory, "reAssign_list");
     }
     static void delete_list(
         const std::vector<str>& parameters,
         const str& return_address,
         SectionMemory& current_memory
     ) {
-
-        for (const auto& listName : parameters) {
-            str size_name = str("___LIST___ENGINE___") + listName + str("___SIZE___");
-            if (!current_memory.m_containsVariable(size_name)) {
-                std::cout << "\n[ERROR_ENGINE] The listName that is causing the error: (" << listName << ")\n";
-                throw std::runtime_error("Couldn't find the list!");
-            }
-            int64_t list_size = std::get<int64_t>(current_memory.m_getVariable(size_name).first);
-            for (int64_t idx = 0; idx < list_size; ++idx) {
-                str at_name = str("___LIST___ENGINE___") +
-                    listName +
-                    str("___") +
-                    std::to_string(idx) +
-                    str("___");
-                current_memory.m_removeVariable(at_name); 
-            }
-            current_memory.m_removeVariable(size_name);
-        }
+        for (const auto& listName : parameters)
+            current_memory.m_removeList(listName);
     }
     static void get(
         const std::vector<str>& parameters,
@@ -293,29 +664,12 @@ public:
 
         if (!current_memory.m_containsVariable(return_address))
             throw std::runtime_error("Couldn't find the return_address, in the function get()!");
-        str listName = parameters[0];
-        str indexStr = parameters[1];
-        if (!indexStr.empty() && (indexStr.front() == '\'' || indexStr.front() == '"')) {
-            indexStr = current_memory.m_fetchStringalizedValue(indexStr);
-        }
-
-        long long idx = 0;
-        try {
-            idx = std::stoll(indexStr); 
-        }
-        catch (...) {
-            throw std::runtime_error("Index for get() is not a valid integer");
-        }
-        str size_name = str("___LIST___ENGINE___") + listName + str("___SIZE___");
-        if (!current_memory.m_containsVariable(size_name))
-            throw std::runtime_error("Couldn't find the list in get()!");
 
-        int64_t list_size = std::get<int64_t>(current_memory.m_getVariable(size_name).first);
-        if (idx < 0 || idx >= list_size)
+        const ListValue& list = current_memory.m_getList(parameters[0]);
+        int64_t idx = pm_resolveIndex(parameters[1], current_memory, "get");
+        if (idx < 0 || idx >= static_cast<int64_t>(list.m_size()))
             throw std::runtime_error("Index out of range in get()");
-        str at_name = str("___LIST___ENGINE___") + listName + str("___") + std::to_string(idx) + str("___");
-        auto var_pair = current_memory.m_getVariable(at_name);
-        current_memory.m_reInsertVariable(return_address, var_pair);
+        current_memory.m_reInsertVariable(return_address, list.m_at(static_cast<size_t>(idx)));
     }
     static void push(
         const std::vector<str>& parameters,
@@ -326,106 +680,296 @@ public:
         if (parameters.size() != 2)
             throw std::runtime_error("push() requires exactly two parameters!");
 
-        str listName = parameters[0];
-        str size_name = str("___LIST___ENGINE___") + listName + str("___SIZE___");
-        if (!current_memory.m_containsVariable(size_name))
-        {
-            std::cout << "\n[ERROR_ENGINE] The listName that is casuing the error: (" << listName << ")\n";
-            throw std::runtime_error("Couldn't find the list!");
-        }
-        int64_t list_size = std::get<int64_t>(current_memory.m_getVariable(size_name).first);
-        str item = parameters[1];
-        if (item.front() == '$')
-            item = current_memory.m_fetchStringalizedValue(item);
-        str new_item_name = str("___LIST___ENGINE___") + listName + str("___")
-            + std::to_string(list_size) + str("___");
-        bool containsDot = false;
-        if (item == "true" || item == "false") {
-            current_memory.m_insertVariable(new_item_name, {
-                item == "true" ? true : false, ENUM_TYPE_BOOL
-                });
-        }
-        else if (isNum(item, containsDot))
-        {
-            long double num = std::stold(item);
-            if (!containsDot) {
-                if (num >= -128 && num <= 127)
-                {
-                    current_memory.m_insertVariable(new_item_name,
-                        { static_cast<int8_t>(num), ENUM_TYPE_I8 });
+        pm_pushItem(current_memory.m_getList(parameters[0]), parameters[1], current_memory, "push");
+    }
+    static void pop(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("pop() requires exactly one parameter!");
 
-                }
-                else if (num >= SHRT_MIN && num <= SHRT_MAX)
-                {
-                    current_memory.m_insertVariable(new_item_name,
-                        { static_cast<int16_t>(num), ENUM_TYPE_I16 });
-                }
-                else if (num >= INT32_MIN && num <= INT32_MAX)
-                {
-                    current_memory.m_insertVariable(new_item_name,
-                        { static_cast<int32_t>(num), ENUM_TYPE_I32 });
-                }
-                else if (num >= INT64_MIN && num <= INT64_MAX)
-                {
-                    current_memory.m_insertVariable(new_item_name,
-                        { static_cast<int64_t>(num), ENUM_TYPE_I64 });
-                }
-                else throw std::runtime_error("Number is to big");
+        current_memory.m_getList(parameters[0]).m_pop();
+    }
+    static void list_size(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("list_size() requires exactly one parameter!");
+
+        if (!current_memory.m_containsVariable(return_address))
+            throw std::runtime_error("Couldn't find the return_address, in the function list_size()!");
+
+        int64_t size = static_cast<int64_t>(current_memory.m_getList(parameters[0]).m_size());
+        current_memory.m_reInsertVariable(return_address, { size, ENUM_TYPE_I64 });
+    }
+    // Fills a packed list in one pass.
+    static void range_list(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        pm_withRange(parameters, current_memory, "range_list", [&](auto tag, auto first, auto step, size_t count) {
+            using T = decltype(tag);
+            std::vector<T> values(count);
+            if constexpr (std::is_floating_point_v<T>) {
+                for (size_t idx = 0; idx < count; ++idx)
+                    values[idx] = static_cast<T>(first + static_cast<double>(idx) * step);
             }
             else {
-                if (num >= FLT_MIN && num <= FLT_MAX)
-                {
-                    current_memory.m_insertVariable(new_item_name,
-                        { static_cast<float>(num), ENUM_TYPE_F32 });
-                }
-                else if (num >= DBL_MIN && num <= DBL_MAX)
-                {
-                    current_memory.m_insertVariable(new_item_name,
-                        { static_cast<double>(num), ENUM_TYPE_F64 });
+                for (size_t idx = 0; idx < count; ++idx)
+                    values[idx] = static_cast<T>(static_cast<int64_t>(static_cast<uint64_t>(first) + idx * static_cast<uint64_t>(step)));
+            }
+            storeList(current_memory, parameters[0], ListValue(std::move(values)));
+            });
+    }
+    // A lazy range: takes O(1) memory and computes elements on access. It is materialized
+    // only when modified or handed to an operation that needs the whole array.
+    static void range(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        pm_withRange(parameters, current_memory, "range", [&](auto tag, auto first, auto step, size_t count) {
+            storeList(current_memory, parameters[0], ListValue::m_range<decltype(tag)>(first, step, count));
+            });
+    }
+    // list_load : (xs, "path", type). Files written by list_save are checked against type; a file
+    // without the header is taken as a bare little-endian array of type. On little-endian hosts
+    // the list reads straight from the mapped file and is only copied if it is modified.
+    static void list_load(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 3)
+            throw std::runtime_error("list_load() requires three parameters! Syntax: (list_name, \"path\", type)");
+        str path = pm_readPath(parameters[1], current_memory, "list_load");
+        uint8_t type_code = pm_binaryTypeCode(parameters[2]);
+        std::shared_ptr<const MappedFile> file = MappedFile::open(path);
+
+        size_t data_offset = 0;
+        bool has_header = file->size() >= pm_binaryHeaderSize && std::memcmp(file->data(), "VLST", 4) == 0;
+        uint64_t header_count = 0;
+        if (has_header) {
+            const unsigned char* header = reinterpret_cast<const unsigned char*>(file->data());
+            if (header[4] != pm_binaryVersion)
+                throw std::runtime_error("Unsupported binary list format version in list_load()!");
+            if (header[5] != type_code) {
+                throw std::runtime_error("The file holds a list of another type than the one passed to list_load()! (" + path + ")");
+            }
+            for (int byte = 7; byte >= 0; --byte)
+                header_count = (header_count << 8) | header[8 + byte];
+            data_offset = pm_binaryHeaderSize;
+        }
+
+        ListValue list = ListValue::m_ofType(parameters[2]).m_visit([&](auto& values) {
+            using T = typename std::decay_t<decltype(values)>::value_type;
+            size_t payload = file->size() - data_offset;
+            if (payload % sizeof(T) != 0 || (has_header && header_count != payload / sizeof(T))) {
+                throw std::runtime_error("The file size doesn't match its element count in list_load()! (" + path + ")");
+            }
+            size_t count = payload / sizeof(T);
+            const char* start = file->data() + data_offset;
+
+            if constexpr (!std::is_same_v<T, value_t>) {
+                if (std::endian::native == std::endian::little && reinterpret_cast<uintptr_t>(start) % alignof(T) == 0)
+                    return ListValue::m_borrow<T>(file, reinterpret_cast<const T*>(start), count);
+                std::vector<T> copied(count);
+                if (count)
+                    std::memcpy(copied.data(), start, count * sizeof(T));
+                if (std::endian::native != std::endian::little)
+                    for (T& value : copied)
+                        value = pm_byteswap(value);
+                return ListValue(std::move(copied));
+            }
+            return ListValue();
+            });
+        storeList(current_memory, parameters[0], std::move(list));
+    }
+    // list_save : (xs, "path") writes a typed list (or a view of one) in list_load()'s format.
+    static void list_save(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2)
+            throw std::runtime_error("list_save() requires two parameters! Syntax: (list_name, \"path\")");
+        const ListValue& list = current_memory.m_getList(parameters[0]);
+        uint8_t type_code = pm_binaryTypeCode(list.m_typeName());
+        str path = pm_readPath(parameters[1], current_memory, "list_save");
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Couldn't open the file for writing! (" + path + ")");
+        }
+        unsigned char header[pm_binaryHeaderSize] = { 'V', 'L', 'S', 'T', pm_binaryVersion, type_code, 0, 0 };
+        uint64_t count = list.m_size();
+        for (int byte = 0; byte < 8; ++byte)
+            header[8 + byte] = static_cast<unsigned char>(count >> (8 * byte));
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+        list.m_visit([&out](auto values) {
+            using T = typename decltype(values)::value_type;
+            if constexpr (!std::is_same_v<T, value_t>) {
+                if (std::endian::native == std::endian::little) {
+                    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
                 }
-                else if (num >= LDBL_MIN && num <= LDBL_MAX)
-                {
-                    current_memory.m_insertVariable(new_item_name,
-                        { static_cast<long double>(num), ENUM_TYPE_FMAX });
+                else {
+                    for (T value : values) {
+                        value = pm_byteswap(value);
+                        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+                    }
                 }
-                else throw std::runtime_error("Number is too big");
             }
+            });
+        if (!out.flush()) {
+            throw std::runtime_error("Writing the list file failed! (" + path + ")");
         }
-        else if (___isChar___(item))
-        {
-            DeclaratorEngine::new_char({ new_item_name , item }, "nullptr", current_memory);
-        }
-        else if (!item.empty() && item.front() == '"' && item.back() == '"') {
-            str inner = item.substr(1, item.length() - 2);
-            current_memory.m_insertVariable(new_item_name, { inner , ENUM_TYPE_STRING });
+    }
+    static void slice(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 3 && parameters.size() != 4)
+            throw std::runtime_error("slice() requires three or four parameters! Syntax: (list_name, start, stop[, step]) ~ view_name");
+
+        const ListValue& list = current_memory.m_getList(parameters[0]);
+        int64_t start = pm_resolveIndex(parameters[1], current_memory, "slice");
+        int64_t stop = pm_resolveIndex(parameters[2], current_memory, "slice");
+        int64_t step = parameters.size() == 4 ? pm_resolveIndex(parameters[3], current_memory, "slice") : 1;
+        if (step <= 0)
+            throw std::runtime_error("Step for slice() must be positive!");
+        if (start < 0 || stop < start || stop > static_cast<int64_t>(list.m_size()))
+            throw std::runtime_error("Bounds out of range in slice(), expected 0 <= start <= stop <= list size");
+
+        storeList(current_memory, return_address,
+            list.m_slice(static_cast<size_t>(start), static_cast<size_t>(stop), static_cast<size_t>(step)));
+    }
+    static void sort(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.empty() || parameters.size() > 3)
+            throw std::runtime_error("sort() takes one to three parameters! Syntax: (list_name[, asc|desc[, stable]])");
+
+        bool descending = false;
+        if (parameters.size() >= 2) {
+            if (parameters[1] != "asc" && parameters[1] != "desc")
+                throw std::runtime_error("The order for sort() must be asc or desc!");
+            descending = parameters[1] == "desc";
         }
-        else {
-            std::cerr << "\n[ERROR_ENGINE] The item which is causing exception is: " << item << '\n';
-            throw std::runtime_error("Bad value for push()");
+        bool stable = false;
+        if (parameters.size() == 3) {
+            if (parameters[2] != "stable")
+                throw std::runtime_error("The third parameter of sort() can only be 'stable'!");
+            stable = true;
         }
-        current_memory.m_reInsertVariable(size_name, { static_cast<int64_t>(list_size + 1), ENUM_TYPE_I64 });
+
+        current_memory.m_getList(parameters[0]).m_visit([descending, stable](auto& values) {
+            using T = typename std::decay_t<decltype(values)>::value_type;
+            if (descending)
+                pm_sort(values, [](const T& left, const T& right) { return pm_less(right, left); }, stable);
+            else
+                pm_sort(values, [](const T& left, const T& right) { return pm_less(left, right); }, stable);
+            });
     }
-    static void pop(
+    static void list_sum(
         const std::vector<str>& parameters,
         const str& return_address,
         SectionMemory& current_memory
     ) {
         if (parameters.size() != 1)
-            throw std::runtime_error("pop() requires exactly one parameter!");
+            throw std::runtime_error("list_sum() requires exactly one parameter!");
+        if (!current_memory.m_containsVariable(return_address))
+            throw std::runtime_error("Couldn't find the return_address, in the function list_sum()!");
+        ListValue scratch;
+        const ListValue& list = pm_numeric(current_memory.m_getList(parameters[0]), scratch, "list_sum");
+        value_t total = list.m_visit([](const auto& values) -> value_t {
+            using T = typename std::decay_t<decltype(values)>::value_type;
+            if constexpr (std::is_same_v<T, value_t>) return { int64_t(0), ENUM_TYPE_I64 };
+            else if constexpr (std::is_same_v<T, int64_t>) return { pm_checkedSum(values), ENUM_TYPE_I64 };
+            else if constexpr (std::is_integral_v<T>) return { pm_sum<int64_t>(values), ENUM_TYPE_I64 };
+            else return { pm_sum<double>(values), ENUM_TYPE_F64 };
+            });
+        current_memory.m_reInsertVariable(return_address, total);
+    }
+    static void list_min(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        pm_extreme(parameters, return_address, current_memory, false, "list_min");
+    }
+    static void list_max(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        pm_extreme(parameters, return_address, current_memory, true, "list_max");
+    }
+    static void list_dot(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2)
+            throw std::runtime_error("list_dot() requires two lists! Syntax: (xs, ys) ~ result");
+        if (!current_memory.m_containsVariable(return_address))
+            throw std::runtime_error("Couldn't find the return_address, in the function list_dot()!");
+        ListValue left_scratch, right_scratch;
+        const ListValue& left = pm_numeric(current_memory.m_getList(parameters[0]), left_scratch, "list_dot");
+        const ListValue& right = pm_numeric(current_memory.m_getList(parameters[1]), right_scratch, "list_dot");
+        if (left.m_size() != right.m_size())
+            throw std::runtime_error("Lists passed to list_dot() must have the same size!");
 
-        str listName = parameters[0];
-        str size_name = str("___LIST___ENGINE___") + listName + str("___SIZE___");
-        if (!current_memory.m_containsVariable(size_name)) {
-            std::cout << "\n[ERROR_ENGINE] The listName that is causing the error: (" << listName << ")\n";
-            throw std::runtime_error("Couldn't find the list!");
+        str type = pm_commonType(left.m_typeName(), right.m_typeName());
+        if (type.front() == 'f') {
+            double total = pm_dot(pm_convert<double>(left), pm_convert<double>(right));
+            current_memory.m_reInsertVariable(return_address, { total, ENUM_TYPE_F64 });
+        }
+        else {
+            std::vector<int64_t> products = pm_combine<int64_t>(pm_convert<int64_t>(left),
+                [rhs = pm_convert<int64_t>(right)](size_t idx) { return rhs[idx]; }, true, "list_dot");
+            current_memory.m_reInsertVariable(return_address, { pm_checkedSum(products), ENUM_TYPE_I64 });
         }
-        int64_t list_size = std::get<int64_t>(current_memory.m_getVariable(size_name).first);
-        if (list_size <= 0)
-            throw std::runtime_error("Cannot pop from an empty list!");
-        str last_element_name = str("___LIST___ENGINE___") +
-            listName + str("___") + std::to_string(list_size - 1) + str("___");
-        current_memory.m_removeVariable(last_element_name); 
-        current_memory.m_reInsertVariable(size_name, { static_cast<int64_t>(list_size - 1), ENUM_TYPE_I64 }); 
+    }
+    static void list_add(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        pm_elementwise(parameters, return_address, current_memory, false, "list_add");
+    }
+    static void list_mul(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        pm_elementwise(parameters, return_address, current_memory, true, "list_mul");
+    }
+    static void list_scale(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2)
+            throw std::runtime_error("list_scale() requires two parameters! Syntax: (xs, factor) ~ result_list");
+        ListValue scratch;
+        const ListValue& list = pm_numeric(current_memory.m_getList(parameters[0]), scratch, "list_scale");
+        value_t factor = parseItem(parameters[1], current_memory, "list_scale");
+
+        ListValue result = pm_withType(pm_commonType(list.m_typeName(), pm_scalarType(factor)), [&](auto tag) {
+            using T = decltype(tag);
+            T k = ListValue::m_toElement<T>(factor);
+            return ListValue(pm_combine<T>(pm_convert<T>(list), [k](size_t) { return k; }, true, "list_scale"));
+            });
+        storeList(current_memory, return_address, std::move(result));
     }
     static void printList(
         const std::vector<str>& parameters,
@@ -435,7 +979,6 @@ public:
         if (parameters.size() != 3)
             throw std::runtime_error("printList() requires 3 parameter!");
 
-        str listName = parameters[0];
         str head = parameters[1];
         str tail = parameters[2];
         if (head.front() == '$')
@@ -447,26 +990,13 @@ public:
 
         if (tail.front() == '"' && tail.front() == '"')
             tail = tail.substr(1, tail.length() - 2);
-        str size_name = str("___LIST___ENGINE___") + listName + str("___SIZE___");
-        if (!current_memory.m_containsVariable(size_name)) {
-            std::cout << "\n[ERROR_ENGINE] The listName that is causing the error: (" << listName << ")\n";
-            throw std::runtime_error("Couldn't find the list!");
-        }
-        int64_t list_size = std::get<int64_t>(current_memory.m_getVariable(size_name).first);
-        bool mask = false;
-        std::cout << head << "[";
-        for (int64_t index = 0; index < list_size; ++index) {
-            str curr_var_name = str("___LIST___ENGINE___") + listName + str("___") +
-                std::to_string(index) + str("___");
-            if (mask)
-                std::cout << ", "; 
-            mask = true;
-            auto val = current_memory.m_getVariable(curr_var_name);
-            if (val.second == ENUM_TYPE_STRING || val.second == ENUM_TYPE_CHAR)
-                std::cout << '"' << makeValueToString(val) << '"'; 
-            else std::cout << makeValueToString(val); 
-        }
-        std::cout << "]" << tail; 
+
+        const auto& value = current_memory.m_getList(parameters[0]);
+        OutputBuffer& output = current_memory.m_output();
+        output.text() += head;
+        value.m_appendTo(output.text());
+        output.text() += tail;
+        output.commit();
     }
 };
 #endif
@@ -60,9 +60,9 @@ public:
      
         int64_t start, stop, step;
         try {
-            start = std::stoll(s_start);
-            stop = std::stoll(s_stop);
-            step = std::stoll(s_step);
+            start = NumberConversion::parse<int64_t>(s_start);
+            stop = NumberConversion::parse<int64_t>(s_stop);
+            step = NumberConversion::parse<int64_t>(s_step);
         }
         catch (...) {
             throw std::runtime_error("Error! number literal too big for int64_t.");
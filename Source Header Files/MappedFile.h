@@ -0,0 +1,112 @@
+#ifndef ___MAPPED___FILE___H___
+#define ___MAPPED___FILE___H___
+
+#include "includes.h"
+#if !defined(_WIN32)
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+// A read-only view of a whole file. On POSIX systems a regular file is mapped into memory, so
+// opening is O(1) and pages are only read when touched. Pipes, devices and /proc files, which
+// report a size of 0, and every file elsewhere are read into a buffer instead.
+// Share it through std::shared_ptr: data() stays valid for as long as any owner is alive.
+class MappedFile {
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    std::vector<char> buffer;
+
+    MappedFile() = default;
+
+#if !defined(_WIN32)
+    // read(2)s the descriptor to its end; used for files that can't be mapped.
+    static void pm_readAll(int descriptor, const std::string& path, MappedFile& file) {
+        size_t filled = 0;
+        file.buffer.resize(1 << 16);
+        for (;;) {
+            if (filled == file.buffer.size())
+                file.buffer.resize(file.buffer.size() * 2);
+            ssize_t count = ::read(descriptor, file.buffer.data() + filled, file.buffer.size() - filled);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count < 0) {
+                ::close(descriptor);
+                throw std::runtime_error("Couldn't read the file! (" + path + ")");
+            }
+            if (count == 0)
+                break;
+            filled += static_cast<size_t>(count);
+        }
+        file.buffer.resize(filled);
+        file.bytes = file.buffer.data();
+        file.length = filled;
+    }
+#endif
+
+public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#if !defined(_WIN32)
+        if (mapped)
+            ::munmap(const_cast<char*>(bytes), length);
+#endif
+    }
+
+    // With sequential set, the kernel is told the file will be read front to back, so it
+    // reads ahead aggressively and drops pages behind the reader early.
+    static std::shared_ptr<const MappedFile> open(const std::string& path, bool sequential = false) {
+        std::shared_ptr<MappedFile> file(new MappedFile());
+#if defined(_WIN32)
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            throw std::runtime_error("Couldn't open the file! (" + path + ")");
+        }
+        file->buffer.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0);
+        in.read(file->buffer.data(), static_cast<std::streamsize>(file->buffer.size()));
+        file->bytes = file->buffer.data();
+        file->length = file->buffer.size();
+#else
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("Couldn't open the file! (" + path + ")");
+        }
+        struct stat info;
+        if (::fstat(descriptor, &info) != 0) {
+            ::close(descriptor);
+            throw std::runtime_error("Couldn't read the size of the file!");
+        }
+        if (!S_ISREG(info.st_mode)) {
+            pm_readAll(descriptor, path, *file);
+            ::close(descriptor);
+            return file;
+        }
+        file->length = static_cast<size_t>(info.st_size);
+        if (file->length) {
+            void* mapping = ::mmap(nullptr, file->length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(descriptor);
+                throw std::runtime_error("Couldn't map the file into memory!");
+            }
+            file->bytes = static_cast<const char*>(mapping);
+            file->mapped = true;
+            if (sequential)
+                ::madvise(mapping, file->length, MADV_SEQUENTIAL);
+        }
+        ::close(descriptor);
+#endif
+        return file;
+    }
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+#endif
+
@@ -2,6 +2,9 @@
 # define ___MEMORY___MODEL___H___
 
 #include "includes.h"
+#include "NumberConversion.h"
+#include "OutputBuffer.h"
+#include "FileHandle.h"
 typedef std::string str; 
 enum typeEnum {
     ENUM_TYPE_I8 = 0x1A3F,
@@ -19,55 +22,52 @@ enum typeEnum {
 typedef std::pair<std::variant<int8_t, int16_t, int32_t, int64_t,
     float, double, long double, bool, char, str>, typeEnum> value_t;
 
-str makeValueToString(const value_t& value) {
-    str result; 
-    auto writeFloat = [](auto v) {
-        std::ostringstream oss;               
-        oss << std::fixed << std::setprecision(6) << v; 
-        return oss.str();                     
-        };
-
+void appendValueToString(str& result, const value_t& value) {
     switch (value.second) {
     case ENUM_TYPE_I8:
-        result = std::to_string(std::get<int8_t>(value.first));
+        NumberConversion::append(result, std::get<int8_t>(value.first));
         break;
     case ENUM_TYPE_I16:
-        result = std::to_string(std::get<int16_t>(value.first));
+        NumberConversion::append(result, std::get<int16_t>(value.first));
         break;
     case ENUM_TYPE_I32:
-        result = std::to_string(std::get<int32_t>(value.first));
+        NumberConversion::append(result, std::get<int32_t>(value.first));
         break;
     case ENUM_TYPE_I64:
-        result = std::to_string(std::get<int64_t>(value.first));
+        NumberConversion::append(result, std::get<int64_t>(value.first));
         break;
     case ENUM_TYPE_F32:
-        result = writeFloat(std::get<float>(value.first));
+        NumberConversion::append(result, std::get<float>(value.first));
         break;
     case ENUM_TYPE_F64:
-        result = writeFloat(std::get<double>(value.first));
+        NumberConversion::append(result, std::get<double>(value.first));
         break;
     case ENUM_TYPE_FMAX:
-        result = writeFloat(std::get<long double>(value.first));
+        NumberConversion::append(result, std::get<long double>(value.first));
         break;
     case ENUM_TYPE_CHAR:
-        result = std::string(1, std::get<char>(value.first));
+        result += std::get<char>(value.first);
         break;
     case ENUM_TYPE_BOOL:
-        std::get<bool>(value.first) ? result = "true" : result = "false";
+        result += std::get<bool>(value.first) ? "true" : "false";
         break;
     case ENUM_TYPE_STRING:
-        result = std::get<str>(value.first);
+        result += std::get<str>(value.first);
         break;
     default:
-        result = "<unknown>";
+        result += "<unknown>";
         break;
     }
-    return result; 
+}
+
+str makeValueToString(const value_t& value) {
+    str result;
+    appendValueToString(result, value);
+    return result;
 }
 
 #define UnorderedMap robin_hood::unordered_map
 void printValue(const value_t& value) {
-    std::cout << std::fixed << std::setprecision(6); 
     switch (value.second) {
     case ENUM_TYPE_I8:
         std::cout << +std::get<int8_t>(value.first);
@@ -82,13 +82,13 @@ void printValue(const value_t& value) {
         std::cout << std::get<int64_t>(value.first);
         break;
     case ENUM_TYPE_F32:
-        std::cout << std::get<float>(value.first);
+        std::cout << NumberConversion::format(std::get<float>(value.first));
         break;
     case ENUM_TYPE_F64:
-        std::cout << std::get<double>(value.first);
+        std::cout << NumberConversion::format(std::get<double>(value.first));
         break;
     case ENUM_TYPE_FMAX:
-        std::cout << std::get<long double>(value.first);
+        std::cout << NumberConversion::format(std::get<long double>(value.first));
         break;
     case ENUM_TYPE_CHAR:
         std::cout << std::get<char>(value.first);
@@ -101,6 +101,400 @@ void printValue(const value_t& value) {
         break;
     }
 }
+// Storage of a ListValue: "dynamic" lists keep a type tag per element, typed lists are packed native arrays.
+typedef std::variant<std::vector<value_t>, std::vector<int8_t>, std::vector<int16_t>, std::vector<int32_t>,
+    std::vector<int64_t>, std::vector<float>, std::vector<double>> list_storage_t;
+
+// A script list held in a single memory slot, with its elements stored contiguously.
+// Storage is shared: copies and slices refer to the same array until one side is
+// mutated, at which point the mutating side takes a private copy (copy-on-write).
+class ListValue {
+private:
+    std::shared_ptr<list_storage_t> storage = std::make_shared<list_storage_t>();
+    // A view covers elements offset, offset + step, ... of the storage, length of them.
+    bool is_view = false;
+    size_t offset = 0;
+    size_t length = 0;
+    size_t step = 1;
+    // A lazy range is a view without backing elements: element idx is computed as
+    // first + idx * step, kept in the widest type of the element kind. Its storage is an
+    // empty array that only records the element type.
+    bool is_range = false;
+    int64_t range_first = 0, range_step = 0;
+    double range_first_f = 0, range_step_f = 0;
+    // A borrowed list reads its elements from memory owned by someone else (a mapped file),
+    // kept alive through external; like a range, its storage only records the element type.
+    std::shared_ptr<const void> external;
+    const void* external_data = nullptr;
+
+    template <typename T>
+    const T* pm_base(const std::vector<T>& values) const {
+        return external ? static_cast<const T*>(external_data) : values.data();
+    }
+
+    template <typename T>
+    T pm_rangeAt(size_t idx) const {
+        if constexpr (std::is_floating_point_v<T>)
+            return static_cast<T>(range_first_f + static_cast<double>(idx) * range_step_f);
+        else
+            return static_cast<T>(static_cast<int64_t>(static_cast<uint64_t>(range_first) +
+                static_cast<uint64_t>(idx) * static_cast<uint64_t>(range_step)));
+    }
+
+public:
+    template <typename T>
+    static constexpr typeEnum m_typeOf() {
+        if constexpr (std::is_same_v<T, int8_t>) return ENUM_TYPE_I8;
+        else if constexpr (std::is_same_v<T, int16_t>) return ENUM_TYPE_I16;
+        else if constexpr (std::is_same_v<T, int32_t>) return ENUM_TYPE_I32;
+        else if constexpr (std::is_same_v<T, int64_t>) return ENUM_TYPE_I64;
+        else if constexpr (std::is_same_v<T, float>) return ENUM_TYPE_F32;
+        else return ENUM_TYPE_F64;
+    }
+
+    // Converts a numeric value into the element type of a typed list, refusing anything that doesn't fit.
+    template <typename T>
+    static T m_toElement(const value_t& value) {
+        return std::visit([](const auto& v) -> T {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<V, bool> || std::is_same_v<V, char> || std::is_same_v<V, str>) {
+                throw std::runtime_error("Only numbers can be stored in a typed list!");
+            }
+            else {
+                if constexpr (std::is_integral_v<T> && std::is_integral_v<V>) {
+                    if (!std::in_range<T>(v))
+                        throw std::runtime_error("Value doesn't fit in the list's element type!");
+                }
+                else if constexpr (std::is_integral_v<T>) {
+                    // -lowest() is a power of two, so the upper bound is exact even for int64_t
+                    if (!(v >= static_cast<V>(std::numeric_limits<T>::lowest()) &&
+                        v < -static_cast<V>(std::numeric_limits<T>::lowest())))
+                        throw std::runtime_error("Value doesn't fit in the list's element type!");
+                }
+                else if constexpr (std::is_floating_point_v<V> && sizeof(V) > sizeof(T)) {
+                    if (std::isfinite(v) && std::fabs(v) > std::numeric_limits<T>::max())
+                        throw std::runtime_error("Value doesn't fit in the list's element type!");
+                }
+                return static_cast<T>(v);
+            }
+            }, value.first);
+    }
+
+    ListValue() = default;
+    explicit ListValue(std::vector<value_t>&& values) : storage(std::make_shared<list_storage_t>(std::move(values))) {}
+    template <typename T>
+    explicit ListValue(std::vector<T>&& values) : storage(std::make_shared<list_storage_t>(std::move(values))) {}
+
+    // A read-only list over count elements at data, which owner keeps alive. Nothing is copied
+    // until the list is modified.
+    template <typename T>
+    static ListValue m_borrow(std::shared_ptr<const void> owner, const T* data, size_t count) {
+        ListValue borrowed(std::vector<T>{});
+        borrowed.is_view = true;
+        borrowed.length = count;
+        borrowed.external = std::move(owner);
+        borrowed.external_data = data;
+        return borrowed;
+    }
+
+    // Packs values into a typed list when they all have the same numeric type, otherwise keeps them dynamic.
+    static ListValue m_fromValues(std::vector<value_t>&& values) {
+        if (values.empty())
+            return ListValue(std::move(values));
+        typeEnum type = values.front().second;
+        for (const auto& value : values)
+            if (value.second != type)
+                return ListValue(std::move(values));
+        auto pack = [&values](auto tag) {
+            using T = decltype(tag);
+            std::vector<T> packed(values.size());
+            for (size_t idx = 0; idx < values.size(); ++idx)
+                packed[idx] = std::get<T>(values[idx].first);
+            return ListValue(std::move(packed));
+        };
+        switch (type) {
+        case ENUM_TYPE_I8: return pack(int8_t{});
+        case ENUM_TYPE_I16: return pack(int16_t{});
+        case ENUM_TYPE_I32: return pack(int32_t{});
+        case ENUM_TYPE_I64: return pack(int64_t{});
+        case ENUM_TYPE_F32: return pack(float{});
+        case ENUM_TYPE_F64: return pack(double{});
+        default: return ListValue(std::move(values));
+        }
+    }
+
+    // An empty list of the given element type: "dynamic", i8, i16, i32, i64, f32 or f64.
+    static ListValue m_ofType(const str& type) {
+        if (type == "dynamic") return ListValue(std::vector<value_t>());
+        if (type == "i8") return ListValue(std::vector<int8_t>());
+        if (type == "i16") return ListValue(std::vector<int16_t>());
+        if (type == "i32") return ListValue(std::vector<int32_t>());
+        if (type == "i64") return ListValue(std::vector<int64_t>());
+        if (type == "f32") return ListValue(std::vector<float>());
+        if (type == "f64") return ListValue(std::vector<double>());
+        throw std::runtime_error("Unknown list type '" + type + "'! Use dynamic, i8, i16, i32, i64, f32 or f64");
+    }
+
+    // A lazy range of count elements of type T: first, first + step, ... given in the wide type W
+    // (int64_t for integer lists, double for float lists).
+    template <typename T, typename W>
+    static ListValue m_range(W first, W range_step, size_t count) {
+        ListValue range(std::vector<T>{});
+        range.is_view = true;
+        range.is_range = true;
+        range.length = count;
+        if constexpr (std::is_floating_point_v<T>) {
+            range.range_first_f = first;
+            range.range_step_f = range_step;
+        }
+        else {
+            range.range_first = first;
+            range.range_step = range_step;
+        }
+        return range;
+    }
+
+    // A view of elements start, start + step, ... below stop, sharing this list's storage.
+    ListValue m_slice(size_t start, size_t stop, size_t slice_step) const {
+        if (slice_step == 0)
+            throw std::runtime_error("Slice step can't be zero!");
+        if (start > stop || stop > m_size())
+            throw std::runtime_error("Slice bounds out of range!");
+        ListValue view = *this;
+        view.is_view = true;
+        view.length = (stop - start + slice_step - 1) / slice_step;
+        if (is_range) {
+            view.range_first = pm_rangeAt<int64_t>(start);
+            view.range_step = static_cast<int64_t>(static_cast<uint64_t>(range_step) * slice_step);
+            view.range_first_f = range_first_f + static_cast<double>(start) * range_step_f;
+            view.range_step_f = range_step_f * static_cast<double>(slice_step);
+            return view;
+        }
+        view.offset = offset + start * step;
+        view.step = step * slice_step;
+        return view;
+    }
+
+    bool m_isPacked() const { return storage->index() != 0; }
+    bool m_isView() const { return is_view; }
+    bool m_isRange() const { return is_range; }
+
+    str m_typeName() const {
+        static const char* names[] = { "dynamic", "i8", "i16", "i32", "i64", "f32", "f64" };
+        return names[storage->index()];
+    }
+
+    // Mutable access hands out the owned std::vector, detaching from any shared storage first.
+    template <typename Fn>
+    decltype(auto) m_visit(Fn&& fn) {
+        pm_detach();
+        return std::visit(std::forward<Fn>(fn), *storage);
+    }
+    // Read-only access hands out a std::span over the elements. Contiguous views are passed
+    // through without copying; strided views and lazy ranges are gathered into a temporary first.
+    template <typename Fn>
+    decltype(auto) m_visit(Fn&& fn) const {
+        return std::visit([this, &fn](const auto& values) -> decltype(auto) {
+            using T = typename std::decay_t<decltype(values)>::value_type;
+            if (!is_view)
+                return fn(std::span<const T>(values));
+            if (step == 1 && !is_range)
+                return fn(std::span<const T>(pm_base(values) + offset, length));
+            std::vector<T> gathered(length);
+            if constexpr (!std::is_same_v<T, value_t>) {
+                if (is_range) {
+                    for (size_t idx = 0; idx < length; ++idx)
+                        gathered[idx] = pm_rangeAt<T>(idx);
+                    return fn(std::span<const T>(gathered));
+                }
+            }
+            const T* base = pm_base(values);
+            for (size_t idx = 0; idx < length; ++idx)
+                gathered[idx] = base[offset + idx * step];
+            return fn(std::span<const T>(gathered));
+            }, *storage);
+    }
+
+private:
+    // Gives this list sole ownership of exactly the elements it shows.
+    void pm_detach() {
+        if (!is_view && storage.use_count() == 1)
+            return;
+        storage = std::as_const(*this).m_visit([](auto values) {
+            using T = typename decltype(values)::value_type;
+            return std::make_shared<list_storage_t>(std::vector<std::remove_const_t<T>>(values.begin(), values.end()));
+            });
+        is_view = false;
+        is_range = false;
+        external.reset();
+        external_data = nullptr;
+        offset = 0;
+        step = 1;
+    }
+
+public:
+    size_t m_size() const {
+        return is_view ? length : std::visit([](const auto& v) { return v.size(); }, *storage);
+    }
+    bool m_empty() const { return m_size() == 0; }
+
+    value_t m_at(size_t idx) const {
+        if (idx >= m_size())
+            throw std::runtime_error("List index out of range!");
+        size_t position = offset + idx * step;
+        return std::visit([this, idx, position](const auto& v) -> value_t {
+            using T = typename std::decay_t<decltype(v)>::value_type;
+            if constexpr (std::is_same_v<T, value_t>) return v[position];
+            else return { is_range ? pm_rangeAt<T>(idx) : pm_base(v)[position], m_typeOf<T>() };
+            }, *storage);
+    }
+    void m_set(size_t idx, value_t value) {
+        if (idx >= m_size())
+            throw std::runtime_error("List index out of range!");
+        m_visit([idx, &value](auto& v) {
+            using T = typename std::decay_t<decltype(v)>::value_type;
+            if constexpr (std::is_same_v<T, value_t>) v[idx] = std::move(value);
+            else v[idx] = m_toElement<T>(value);
+            });
+    }
+
+    void m_push(value_t value) {
+        m_visit([&value](auto& v) {
+            using T = typename std::decay_t<decltype(v)>::value_type;
+            if constexpr (std::is_same_v<T, value_t>) v.push_back(std::move(value));
+            else v.push_back(m_toElement<T>(value));
+            });
+    }
+    void m_pop() {
+        if (m_empty())
+            throw std::runtime_error("Cannot pop from an empty list!");
+        m_visit([](auto& v) { v.pop_back(); });
+    }
+    void m_reserve(size_t count) { m_visit([count](auto& v) { v.reserve(count); }); }
+
+    void m_appendTo(str& out) const {
+        out += '[';
+        m_visit([&out](auto v) {
+            using T = typename decltype(v)::value_type;
+            for (size_t idx = 0; idx < v.size(); ++idx) {
+                if (idx)
+                    out += ", ";
+                if constexpr (std::is_same_v<std::remove_const_t<T>, value_t>) {
+                    bool quoted = v[idx].second == ENUM_TYPE_STRING || v[idx].second == ENUM_TYPE_CHAR;
+                    if (quoted) out += '"';
+                    appendValueToString(out, v[idx]);
+                    if (quoted) out += '"';
+                }
+                else NumberConversion::append(out, v[idx]);
+            }
+            });
+        out += ']';
+    }
+};
+
+// A script dictionary. Keys are normalized so that equal numbers of different widths
+// (1, 1.0 and an i8 holding 1) address the same entry; values keep their own types.
+class DictValue {
+public:
+    typedef std::variant<int64_t, double, bool, char, str> key_t;
+
+    struct KeyHash {
+        template <typename K, size_t I = 0>
+        static constexpr size_t pm_indexOf() {
+            if constexpr (std::is_same_v<K, std::variant_alternative_t<I, key_t>>) return I;
+            else return pm_indexOf<K, I + 1>();
+        }
+
+        // Hashes one alternative of key_t without building the variant. Also behind @hash, so
+        // scripts see the same hashes that dictionaries use.
+        template <typename K>
+        static size_t m_hash(const K& k) noexcept {
+            size_t h;
+            if constexpr (std::is_same_v<K, str>) h = robin_hood::hash_bytes(k.data(), k.size());
+            else if constexpr (std::is_same_v<K, double>) h = robin_hood::hash_bytes(&k, sizeof(k));
+            else h = robin_hood::hash_int(static_cast<uint64_t>(k));
+            return h ^ pm_indexOf<K>();
+        }
+
+        size_t operator()(const key_t& key) const noexcept {
+            return std::visit([](const auto& k) { return m_hash(k); }, key);
+        }
+    };
+
+private:
+    robin_hood::unordered_map<key_t, value_t, KeyHash> entries;
+
+public:
+    static key_t m_makeKey(const value_t& value) {
+        return std::visit([](const auto& v) -> key_t {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<V, bool> || std::is_same_v<V, char> || std::is_same_v<V, str>)
+                return v;
+            else if constexpr (std::is_integral_v<V>)
+                return static_cast<int64_t>(v);
+            else {
+                if (std::isnan(v))
+                    throw std::runtime_error("NaN can't be used as a dictionary key!");
+                if (std::trunc(v) == v && v >= -0x1p63L && v < 0x1p63L)
+                    return static_cast<int64_t>(v);
+                return static_cast<double>(v);
+            }
+            }, value.first);
+    }
+    static value_t m_keyValue(const key_t& key) {
+        switch (key.index()) {
+        case 0: return { std::get<int64_t>(key), ENUM_TYPE_I64 };
+        case 1: return { std::get<double>(key), ENUM_TYPE_F64 };
+        case 2: return { std::get<bool>(key), ENUM_TYPE_BOOL };
+        case 3: return { std::get<char>(key), ENUM_TYPE_CHAR };
+        default: return { std::get<str>(key), ENUM_TYPE_STRING };
+        }
+    }
+
+    void m_set(const value_t& key, value_t value) { entries[m_makeKey(key)] = std::move(value); }
+    const value_t* m_find(const value_t& key) const {
+        auto found = entries.find(m_makeKey(key));
+        return found == entries.end() ? nullptr : &found->second;
+    }
+    bool m_erase(const value_t& key) { return entries.erase(m_makeKey(key)) != 0; }
+    size_t m_size() const { return entries.size(); }
+
+    ListValue m_keys() const {
+        std::vector<value_t> keys;
+        keys.reserve(entries.size());
+        for (const auto& entry : entries)
+            keys.push_back(m_keyValue(entry.first));
+        return ListValue(std::move(keys));
+    }
+    ListValue m_values() const {
+        std::vector<value_t> values;
+        values.reserve(entries.size());
+        for (const auto& entry : entries)
+            values.push_back(entry.second);
+        return ListValue(std::move(values));
+    }
+
+    void m_appendTo(str& out) const {
+        auto append = [&out](const value_t& value) {
+            bool quoted = value.second == ENUM_TYPE_STRING || value.second == ENUM_TYPE_CHAR;
+            if (quoted) out += '"';
+            appendValueToString(out, value);
+            if (quoted) out += '"';
+        };
+        out += '{';
+        bool first = true;
+        for (const auto& entry : entries) {
+            if (!first)
+                out += ", ";
+            first = false;
+            append(m_keyValue(entry.first));
+            out += ": ";
+            append(entry.second);
+        }
+        out += '}';
+    }
+};
+
 class SectionMemory {
 private:
     UnorderedMap<str, int8_t> Buffer_I8;
@@ -114,8 +508,36 @@ private:
     UnorderedMap<str, char> Buffer_Char;
     UnorderedMap<str, str> Buffer_String;
     UnorderedMap<str, typeEnum> varLocations;
+    // Lists live in their own namespace, keyed by list name.
+    robin_hood::unordered_node_map<str, ListValue> Buffer_List;
+    // Dictionaries likewise have their own namespace.
+    robin_hood::unordered_node_map<str, DictValue> Buffer_Dict;
+    // Files opened with @open, by handle name.
+    robin_hood::unordered_node_map<str, std::shared_ptr<FileHandle>> Buffer_File;
+    // String builders from @sb_new; appending grows them in place.
+    robin_hood::unordered_node_map<str, str> Buffer_Builder;
+    // Where print and friends write to; owned by the VM that built this memory.
+    OutputBuffer* output = nullptr;
+    // Where @input reads from; also owned by the VM.
+    InputSource* input = nullptr;
+
+    // Moves the slot's payload into the receiver, so strings change owner instead of being copied.
+    template <typename Map>
+    static void pm_moveSlot(Map& from, Map& to, const str& varName) {
+        auto found = from.find(varName);
+        to.emplace(varName, std::move(found->second));
+        from.erase(found);
+    }
 
 public:
+    OutputBuffer& m_output() { return output ? *output : OutputBuffer::standard(); }
+    void m_setOutput(OutputBuffer* buffer) { output = buffer; }
+    InputSource& m_input() {
+        static StreamSource standard(std::cin);
+        return input ? *input : standard;
+    }
+    void m_setInput(InputSource* source) { input = source; }
+
     void m_insertVariable(const std::string& varName, const value_t& value) {
         if (varLocations.contains(varName))
             throw std::runtime_error("Variable already exists; use reInsertVariable().");
@@ -199,9 +621,23 @@ public:
         varLocations.erase(varName);
     }
     void m_reInsertVariable(const str& varName, const value_t& value) {
-        if (!varLocations.contains(varName))
+        auto location = varLocations.find(varName);
+        if (location == varLocations.end())
             throw std::runtime_error("Variable doesn't exisit at all. Use insertVariable()");
 
+        // Same type as before: overwrite the slot instead of erasing and re-inserting the key.
+        if (location->second == value.second) {
+            bool assigned = std::visit([this, &varName](const auto& v) {
+                using T = std::decay_t<decltype(v)>;
+                T* slot = m_findTyped<T>(varName);
+                if (slot)
+                    *slot = v;
+                return slot != nullptr;
+                }, value.first);
+            if (assigned)
+                return;
+        }
+
         const auto& v = value.first;
         const auto t = value.second; 
         m_removeVariable(varName);
@@ -275,22 +711,217 @@ public:
     void m_passVariabe(const str& varName, SectionMemory& to) {
         if (to.varLocations.contains(varName))
             throw std::runtime_error("Error! Variable already exists at the reciver.");
-        if (!varLocations.contains(varName))
-            throw std::runtime_error("Variable doesn't exists.");
-        to.m_insertVariable(varName, m_getVariable(varName));
-        m_removeVariable(varName);
+        auto location = varLocations.find(varName);
+        if (location == varLocations.end()) {
+            if (Buffer_Builder.contains(varName)) {
+                if (to.Buffer_Builder.contains(varName))
+                    throw std::runtime_error("Error! String builder already exists at the reciver.");
+                pm_moveSlot(Buffer_Builder, to.Buffer_Builder, varName);
+                return;
+            }
+            if (Buffer_File.contains(varName)) {
+                if (to.Buffer_File.contains(varName))
+                    throw std::runtime_error("Error! File already exists at the reciver.");
+                pm_moveSlot(Buffer_File, to.Buffer_File, varName);
+                return;
+            }
+            if (Buffer_Dict.contains(varName)) {
+                if (to.Buffer_Dict.contains(varName))
+                    throw std::runtime_error("Error! Dictionary already exists at the reciver.");
+                pm_moveSlot(Buffer_Dict, to.Buffer_Dict, varName);
+                return;
+            }
+            if (!Buffer_List.contains(varName))
+                throw std::runtime_error("Variable doesn't exists.");
+            if (to.Buffer_List.contains(varName))
+                throw std::runtime_error("Error! List already exists at the reciver.");
+            pm_moveSlot(Buffer_List, to.Buffer_List, varName);
+            return;
+        }
+
+        typeEnum t = location->second;
+        switch (t) {
+        case ENUM_TYPE_I8:
+            pm_moveSlot(Buffer_I8, to.Buffer_I8, varName);
+            break;
+        case ENUM_TYPE_I16:
+            pm_moveSlot(Buffer_I16, to.Buffer_I16, varName);
+            break;
+        case ENUM_TYPE_I32:
+            pm_moveSlot(Buffer_I32, to.Buffer_I32, varName);
+            break;
+        case ENUM_TYPE_I64:
+            pm_moveSlot(Buffer_I64, to.Buffer_I64, varName);
+            break;
+        case ENUM_TYPE_F32:
+            pm_moveSlot(Buffer_F32, to.Buffer_F32, varName);
+            break;
+        case ENUM_TYPE_F64:
+            pm_moveSlot(Buffer_F64, to.Buffer_F64, varName);
+            break;
+        case ENUM_TYPE_FMAX:
+            pm_moveSlot(Buffer_Fmax, to.Buffer_Fmax, varName);
+            break;
+        case ENUM_TYPE_BOOL:
+            pm_moveSlot(Buffer_Bool, to.Buffer_Bool, varName);
+            break;
+        case ENUM_TYPE_CHAR:
+            pm_moveSlot(Buffer_Char, to.Buffer_Char, varName);
+            break;
+        case ENUM_TYPE_STRING:
+            pm_moveSlot(Buffer_String, to.Buffer_String, varName);
+            break;
+        default:
+            throw std::runtime_error("Unknown typeEnum in passVariable().");
+        }
+        varLocations.erase(location);
+        to.varLocations.emplace(varName, t);
     }
     bool m_containsVariable(const str& varName) {
         return varLocations.contains(varName);
     }
 
+    typeEnum m_getType(const str& varName) {
+        auto found = varLocations.find(varName);
+        if (found == varLocations.end())
+            throw std::runtime_error("Variable does not exist.");
+        return found->second;
+    }
+
+    template <typename T>
+    T* m_findTyped(const str& varName) {
+        UnorderedMap<str, T>* buffer = nullptr;
+        if constexpr (std::is_same_v<T, int8_t>) buffer = &Buffer_I8;
+        else if constexpr (std::is_same_v<T, int16_t>) buffer = &Buffer_I16;
+        else if constexpr (std::is_same_v<T, int32_t>) buffer = &Buffer_I32;
+        else if constexpr (std::is_same_v<T, int64_t>) buffer = &Buffer_I64;
+        else if constexpr (std::is_same_v<T, float>) buffer = &Buffer_F32;
+        else if constexpr (std::is_same_v<T, double>) buffer = &Buffer_F64;
+        else if constexpr (std::is_same_v<T, long double>) buffer = &Buffer_Fmax;
+        else if constexpr (std::is_same_v<T, bool>) buffer = &Buffer_Bool;
+        else if constexpr (std::is_same_v<T, char>) buffer = &Buffer_Char;
+        else buffer = &Buffer_String;
+
+        auto found = buffer->find(varName);
+        return found == buffer->end() ? nullptr : &found->second;
+    }
+
+    bool m_containsList(const str& listName) {
+        return Buffer_List.contains(listName);
+    }
+
+    void m_insertList(const str& listName, ListValue&& list) {
+        if (Buffer_List.contains(listName)) {
+            throw std::runtime_error("List already exsists! (" + listName + ")");
+        }
+        Buffer_List.emplace(listName, std::move(list));
+    }
+
+    ListValue* m_findList(const str& listName) {
+        auto found = Buffer_List.find(listName);
+        return found == Buffer_List.end() ? nullptr : &found->second;
+    }
+
+    ListValue& m_getList(const str& listName) {
+        auto found = Buffer_List.find(listName);
+        if (found == Buffer_List.end()) {
+            throw std::runtime_error("Couldn't find the list! (" + listName + ")");
+        }
+        return found->second;
+    }
+
+    void m_removeList(const str& listName) {
+        if (Buffer_List.erase(listName) == 0) {
+            throw std::runtime_error("Couldn't find the list! (" + listName + ")");
+        }
+    }
+
+    bool m_containsDict(const str& dictName) {
+        return Buffer_Dict.contains(dictName);
+    }
+
+    void m_insertDict(const str& dictName) {
+        if (Buffer_Dict.contains(dictName)) {
+            throw std::runtime_error("Dictionary already exsists! (" + dictName + ")");
+        }
+        Buffer_Dict.emplace(dictName, DictValue());
+    }
+
+    DictValue& m_getDict(const str& dictName) {
+        auto found = Buffer_Dict.find(dictName);
+        if (found == Buffer_Dict.end()) {
+            throw std::runtime_error("Couldn't find the dictionary! (" + dictName + ")");
+        }
+        return found->second;
+    }
+
+    void m_removeDict(const str& dictName) {
+        if (Buffer_Dict.erase(dictName) == 0) {
+            throw std::runtime_error("Couldn't find the dictionary! (" + dictName + ")");
+        }
+    }
+
+    bool m_containsFile(const str& fileName) {
+        return Buffer_File.contains(fileName);
+    }
+
+    // Binds an open file to fileName, closing any file already bound to it.
+    void m_insertFile(const str& fileName, std::shared_ptr<FileHandle> file) {
+        auto found = Buffer_File.find(fileName);
+        if (found != Buffer_File.end()) {
+            found->second->close();
+            found->second = std::move(file);
+            return;
+        }
+        Buffer_File.emplace(fileName, std::move(file));
+    }
+
+    FileHandle& m_getFile(const str& fileName) {
+        return *m_shareFile(fileName);
+    }
+
+    // Like m_getFile(), but keeps the handle alive even if the program closes the file.
+    const std::shared_ptr<FileHandle>& m_shareFile(const str& fileName) {
+        auto found = Buffer_File.find(fileName);
+        if (found == Buffer_File.end()) {
+            throw std::runtime_error("Couldn't find the file! (" + fileName + ")");
+        }
+        return found->second;
+    }
+
+    void m_removeFile(const str& fileName) {
+        if (Buffer_File.erase(fileName) == 0) {
+            throw std::runtime_error("Couldn't find the file! (" + fileName + ")");
+        }
+    }
+
+    bool m_containsBuilder(const str& builderName) {
+        return Buffer_Builder.contains(builderName);
+    }
+
+    void m_insertBuilder(const str& builderName) {
+        if (Buffer_Builder.contains(builderName)) {
+            throw std::runtime_error("String builder already exsists! (" + builderName + ")");
+        }
+        Buffer_Builder.emplace(builderName, str());
+    }
+
+    str& m_getBuilder(const str& builderName) {
+        auto found = Buffer_Builder.find(builderName);
+        if (found == Buffer_Builder.end()) {
+            throw std::runtime_error("Couldn't find the string builder! (" + builderName + ")");
+        }
+        return found->second;
+    }
+
+    void m_removeBuilder(const str& builderName) {
+        if (Buffer_Builder.erase(builderName) == 0) {
+            throw std::runtime_error("Couldn't find the string builder! (" + builderName + ")");
+        }
+    }
+
     void m_monitorVariables() {
         std::cout << "|===============================================|\n";
-        auto formatFloat = [](auto val) {
-            std::ostringstream oss;
-            oss << std::fixed << std::setprecision(6) << val;
-            return oss.str();
-            };
         if (!Buffer_I8.empty()) {
             std::cout << "BUFFER_I8: \n";
             int idx = 0;
@@ -331,7 +962,7 @@ public:
             std::cout << "\nBUFFER_F32: \n";
             int idx = 0;
             for (auto& item : Buffer_F32) {
-                std::cout << '[' << idx << "] " << item.first << ": " << formatFloat(item.second) << '\n';
+                std::cout << '[' << idx << "] " << item.first << ": " << NumberConversion::format(item.second) << '\n';
                 idx++;
             }
         }
@@ -340,7 +971,7 @@ public:
             std::cout << "\nBUFFER_F64: \n";
             int idx = 0;
             for (auto& item : Buffer_F64) {
-                std::cout << '[' << idx << "] " << item.first << ": " << formatFloat(item.second) << '\n';
+                std::cout << '[' << idx << "] " << item.first << ": " << NumberConversion::format(item.second) << '\n';
                 idx++;
             }
         }
@@ -349,7 +980,7 @@ public:
             std::cout << "\nBUFFER_FMAX: \n";
             int idx = 0;
             for (auto& item : Buffer_Fmax) {
-                std::cout << '[' << idx << "] " << item.first << ": " << formatFloat(item.second) << '\n';
+                std::cout << '[' << idx << "] " << item.first << ": " << NumberConversion::format(item.second) << '\n';
                 idx++;
             }
         }
@@ -381,6 +1012,43 @@ public:
                 idx++;
             }
         }
+        if (!Buffer_List.empty()) {
+            std::cout << "\nBUFFER_LIST: \n";
+            int idx = 0;
+            for (auto& item : Buffer_List) {
+                str contents;
+                item.second.m_appendTo(contents);
+                std::cout << '[' << idx << "] " << item.first << ": " << contents << '\n';
+                idx++;
+            }
+        }
+        if (!Buffer_Dict.empty()) {
+            std::cout << "\nBUFFER_DICT: \n";
+            int idx = 0;
+            for (auto& item : Buffer_Dict) {
+                str contents;
+                item.second.m_appendTo(contents);
+                std::cout << '[' << idx << "] " << item.first << ": " << contents << '\n';
+                idx++;
+            }
+        }
+        if (!Buffer_File.empty()) {
+            std::cout << "\nBUFFER_FILE: \n";
+            int idx = 0;
+            for (auto& item : Buffer_File) {
+                std::cout << '[' << idx << "] " << item.first << ": \"" << item.second->name() << '"'
+                    << (item.second->isWritable() ? " (write)" : " (read)") << '\n';
+                idx++;
+            }
+        }
+        if (!Buffer_Builder.empty()) {
+            std::cout << "\nBUFFER_BUILDER: \n";
+            int idx = 0;
+            for (auto& item : Buffer_Builder) {
+                std::cout << '[' << idx << "] " << item.first << ": \"" << item.second << '"' << '\n';
+                idx++;
+            }
+        }
         if (!varLocations.empty()) {
             std::cout << "\nVAR_LOCATIONS_BLUEPRINT: \n";
             int idx = 0;
@@ -425,18 +1093,44 @@ public:
             }
         }
 
-        std::cout << "\n|===============================================|\n\n";
+        std::cout << "\n|===============================================|\n\n" << std::flush;
     }
     str m_fetchStringalizedValue(str& var_name) {
         var_name = var_name.substr(1);
-        if (!m_containsVariable(var_name)) {
-            std::cerr <<
-                "\n[ERROR_ENGINE]  The var_name that is causing exception is: ("
-                << var_name << ")\n";
+        str result;
+        m_appendStringalizedValue(result, var_name);
+        return result;
+    }
+
+    // Formats straight from the typed buffer, without building a value_t copy first.
+    void m_appendStringalizedValue(str& out, const str& varName) {
+        auto location = varLocations.find(varName);
+        if (location == varLocations.end()) {
+            throw std::runtime_error("Can't find the variable! (" + varName + ")");
+        }
+        switch (location->second) {
+        case ENUM_TYPE_I8: NumberConversion::append(out, Buffer_I8.find(varName)->second); break;
+        case ENUM_TYPE_I16: NumberConversion::append(out, Buffer_I16.find(varName)->second); break;
+        case ENUM_TYPE_I32: NumberConversion::append(out, Buffer_I32.find(varName)->second); break;
+        case ENUM_TYPE_I64: NumberConversion::append(out, Buffer_I64.find(varName)->second); break;
+        case ENUM_TYPE_F32: NumberConversion::append(out, Buffer_F32.find(varName)->second); break;
+        case ENUM_TYPE_F64: NumberConversion::append(out, Buffer_F64.find(varName)->second); break;
+        case ENUM_TYPE_FMAX: NumberConversion::append(out, Buffer_Fmax.find(varName)->second); break;
+        case ENUM_TYPE_BOOL: out += Buffer_Bool.find(varName)->second ? "true" : "false"; break;
+        case ENUM_TYPE_CHAR: out += Buffer_Char.find(varName)->second; break;
+        case ENUM_TYPE_STRING: out += Buffer_String.find(varName)->second; break;
+        default: out += "<unknown>"; break;
+        }
+    }
 
-            throw std::runtime_error("Can't find the variable!");
+    int64_t m_fetchInteger(const str& varName) {
+        switch (m_getType(varName)) {
+        case ENUM_TYPE_I8: return Buffer_I8.find(varName)->second;
+        case ENUM_TYPE_I16: return Buffer_I16.find(varName)->second;
+        case ENUM_TYPE_I32: return Buffer_I32.find(varName)->second;
+        case ENUM_TYPE_I64: return Buffer_I64.find(varName)->second;
+        default: return NumberConversion::parse<int64_t>(makeValueToString(m_getVariable(varName)));
         }
-        return makeValueToString(m_getVariable(var_name));
     }
 };
 
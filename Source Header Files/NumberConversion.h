@@ -0,0 +1,78 @@
+#ifndef ___NUMBER___CONVERSION___H___
+#define ___NUMBER___CONVERSION___H___
+
+#include "includes.h"
+
+// Locale-independent text <-> number conversion on top of std::from_chars / std::to_chars.
+// Parsing follows std::stoll/std::stold: leading spaces and a '+' are skipped, and an integer
+// stops at the first non-digit ("3.7" reads as 3). Floats are written in the shortest fixed
+// form that round-trips, always with a '.', so the output still passes the engines' isNum checks.
+class NumberConversion {
+private:
+    static std::string_view pm_trim(std::string_view text) {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+            text.remove_prefix(1);
+        if (text.size() > 1 && text.front() == '+' && text[1] != '-' && text[1] != '+')
+            text.remove_prefix(1);
+        return text;
+    }
+
+public:
+    template <typename T>
+    static std::errc tryParse(std::string_view text, T& out, int base = 10) {
+        text = pm_trim(text);
+        const char* first = text.data();
+        const char* last = first + text.size();
+        std::from_chars_result result;
+        if constexpr (std::is_integral_v<T>)
+            result = std::from_chars(first, last, out, base);
+        else
+            result = std::from_chars(first, last, out, std::chars_format::general);
+        if (result.ec == std::errc() && result.ptr == first)
+            return std::errc::invalid_argument;
+        return result.ec;
+    }
+
+    template <typename T>
+    static T parse(std::string_view text, int base = 10) {
+        T value{};
+        std::errc ec = tryParse(text, value, base);
+        if (ec == std::errc::result_out_of_range)
+            throw std::runtime_error("Number out of range: '" + std::string(text) + "'");
+        if (ec != std::errc())
+            throw std::runtime_error("Bad number: '" + std::string(text) + "'");
+        return value;
+    }
+
+    template <typename T>
+    static void append(std::string& out, T value) {
+        char buffer[64];
+        if constexpr (std::is_integral_v<T>) {
+            out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+        }
+        else {
+            size_t begin = out.size();
+            std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed);
+            if (result.ec == std::errc()) {
+                out.append(buffer, result.ptr);
+            }
+            else {
+                // only huge magnitudes overflow the stack buffer in fixed notation
+                out.resize(begin + std::numeric_limits<T>::max_exponent10 + std::numeric_limits<T>::max_digits10 + 8);
+                result = std::to_chars(out.data() + begin, out.data() + out.size(), value, std::chars_format::fixed);
+                out.resize(result.ptr - out.data());
+            }
+            if (std::isfinite(value) && out.find('.', begin) == std::string::npos)
+                out += ".0";
+        }
+    }
+
+    template <typename T>
+    static std::string format(T value) {
+        std::string result;
+        append(result, value);
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef ___OUTPUT___BUFFER___H___
+#define ___OUTPUT___BUFFER___H___
+
+#include "includes.h"
+#include "IOSinks.h"
+
+// Collects program output in one growable byte buffer and hands it to the sink once it
+// fills up, on flush() and on destruction. Engines format straight into text() and then
+// call commit(). In line-buffered mode (the default for interactive sinks) every commit
+// that ends a line is passed on immediately. Only flush() asks the sink to flush as well,
+// so a line-buffered commit into an AsyncSink doesn't wait for the drain.
+class OutputBuffer {
+private:
+    static constexpr size_t pm_capacity = 1 << 16;
+
+    std::shared_ptr<OutputSink> sink;
+    // Either `buffer` or the sink's own storage, see OutputSink::storage().
+    std::string* target;
+    bool lineBuffered;
+    std::string buffer;
+
+    // Writes the buffer to the sink. Dropped even if the sink throws, so the same bytes
+    // aren't offered to it again.
+    void pm_handOff() {
+        if (buffer.empty())
+            return;
+        try { sink->write(buffer); }
+        catch (...) {
+            buffer.clear();
+            throw;
+        }
+        buffer.clear();
+    }
+
+public:
+    explicit OutputBuffer(std::shared_ptr<OutputSink> to = std::make_shared<FdSink>(1))
+        : sink(std::move(to)) {
+        target = sink->storage() ? sink->storage() : &buffer;
+        lineBuffered = sink->interactive();
+        buffer.reserve(pm_capacity);
+    }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    ~OutputBuffer() {
+        try { flush(); }
+        catch (...) {}
+    }
+
+    // The buffer used by memories that don't belong to a VM.
+    static OutputBuffer& standard() {
+        static OutputBuffer instance;
+        return instance;
+    }
+
+    std::string& text() { return *target; }
+
+    // Call after appending to text(): passes the buffer on if it is full, or if it
+    // holds a complete line while line buffered.
+    void commit() {
+        if (target != &buffer)
+            return;
+        if (buffer.size() >= pm_capacity ||
+            (lineBuffered && buffer.find('\n') != std::string::npos))
+            pm_handOff();
+    }
+
+    void write(std::string_view bytes) {
+        target->append(bytes);
+        commit();
+    }
+
+    void flush() {
+        pm_handOff();
+        sink->flush();
+    }
+
+    // Flushes everything written so far to the old sink and continues with the new one.
+    void setSink(std::shared_ptr<OutputSink> to) {
+        flush();
+        sink = std::move(to);
+        target = sink->storage() ? sink->storage() : &buffer;
+        lineBuffered = sink->interactive();
+    }
+    const std::shared_ptr<OutputSink>& getSink() const { return sink; }
+
+    void setLineBuffered(bool enabled) {
+        lineBuffered = enabled;
+        if (enabled)
+            commit();
+    }
+    bool isLineBuffered() const { return lineBuffered; }
+};
+#endif
@@ -0,0 +1,59 @@
+#ifndef ___PARALLEL___H___
+#define ___PARALLEL___H___
+
+#include "includes.h"
+
+// Small helper for running independent work on all cores. Threads pull chunks from a shared
+// atomic cursor, so a worker that finishes early keeps taking chunks instead of sitting idle.
+class Parallel {
+public:
+    static size_t workerCount() {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Calls fn(begin, end) for consecutive chunks of [0, count), each at most grain long.
+    // The calling thread takes part. The first exception stops further chunks from starting
+    // and is rethrown here once every worker has finished.
+    template <typename Fn>
+    static void forChunks(size_t count, size_t grain, Fn&& fn) {
+        if (count == 0)
+            return;
+        grain = std::max<size_t>(grain, 1);
+        size_t chunks = (count + grain - 1) / grain;
+        size_t workers = std::min(workerCount(), chunks);
+
+        std::atomic<size_t> cursor{ 0 };
+        std::atomic<bool> failed{ false };
+        std::exception_ptr error;
+        std::mutex error_lock;
+
+        auto work = [&] {
+            for (;;) {
+                size_t chunk = cursor.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= chunks || failed.load(std::memory_order_relaxed))
+                    return;
+                try {
+                    fn(chunk * grain, std::min(count, (chunk + 1) * grain));
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> guard(error_lock);
+                    if (!error)
+                        error = std::current_exception();
+                    failed = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (size_t worker = 1; worker < workers; ++worker)
+            threads.emplace_back(work);
+        work();
+        for (auto& thread : threads)
+            thread.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
+};
+#endif
+
@@ -46,7 +46,7 @@ public:
         if (!___isNum___(left) || !___isNum___(right))
             throw std::runtime_error("Use isCharsEqual()");
 
-        bool result = ___floatEquals___(std::stold(left), std::stold(right));
+        bool result = ___floatEquals___(NumberConversion::parse<long double>(left), NumberConversion::parse<long double>(right));
 
         auto ra = current_memory.m_getVariable(return_address);
 
@@ -72,7 +72,7 @@ public:
         if (!___isNum___(left) || !___isNum___(right))
             throw std::invalid_argument("All the values must be valid numbers!");
 
-        bool result = (std::stold(left) > std::stold(right));
+        bool result = (NumberConversion::parse<long double>(left) > NumberConversion::parse<long double>(right));
 
         auto ra = current_memory.m_getVariable(return_address);
         if (ra.second != ENUM_TYPE_BOOL)
@@ -97,7 +97,7 @@ public:
         if (!___isNum___(left) || !___isNum___(right))
             throw std::invalid_argument("All the values must be valid numbers!");
 
-        bool result = (std::stold(left) < std::stold(right));
+        bool result = (NumberConversion::parse<long double>(left) < NumberConversion::parse<long double>(right));
 
         auto ra = current_memory.m_getVariable(return_address);
         if (ra.second != ENUM_TYPE_BOOL)
@@ -122,7 +122,7 @@ public:
         if (!___isNum___(left) || !___isNum___(right))
             throw std::invalid_argument("All the values must be valid numbers!");
 
-        bool result = (std::stold(left) >= std::stold(right));
+        bool result = (NumberConversion::parse<long double>(left) >= NumberConversion::parse<long double>(right));
 
         auto ra = current_memory.m_getVariable(return_address);
         if (ra.second != ENUM_TYPE_BOOL)
@@ -147,7 +147,7 @@ public:
         if (!___isNum___(left) || !___isNum___(right))
             throw std::invalid_argument("All the values must be valid numbers!");
 
-        bool result = (std::stold(left) <= std::stold(right));
+        bool result = (NumberConversion::parse<long double>(left) <= NumberConversion::parse<long double>(right));
 
         auto ra = current_memory.m_getVariable(return_address);
         if (ra.second != ENUM_TYPE_BOOL)
@@ -172,7 +172,7 @@ public:
         if (!___isNum___(left) || !___isNum___(right))
             throw std::invalid_argument("Use isCharsNotEqual");
 
-        bool result = !___floatEquals___(std::stold(left), std::stold(right));
+        bool result = !___floatEquals___(NumberConversion::parse<long double>(left), NumberConversion::parse<long double>(right));
 
         auto ra = current_memory.m_getVariable(return_address);
         if (ra.second != ENUM_TYPE_BOOL)
@@ -0,0 +1,236 @@
+#ifndef ___STRING___ENGINE___H___
+#define ___STRING___ENGINE___H___
+
+#include "MemoryModel.h"
+#include "IOEngine.h"
+#include "ListEngine.h"
+#if !defined(_WIN32)
+#    include <string.h>
+#endif
+// String builders, for strings assembled piece by piece. Rebuilding a string variable with
+// every step copies everything gathered so far; a builder grows in place instead:
+//   @sb_new : (b);
+//   @sb_append : (b, "x = ", $x, ", ");     items are formatted like @print's
+//   @sb_finish : (b) ~ s;                   moves the text into s and drops the builder
+//
+// String operations; positions count bytes from 0:
+//   @find : ($s, "needle") ~ i;             first position at or after an optional start, or -1
+//   @contains : ($s, "needle") ~ b;
+//   @starts_with : ($s, "pre") ~ b;         and @ends_with
+//   @substr : ($s, start, length) ~ t;      length is optional and may run past the end
+//   @replace : ($s, "from", "to") ~ t;      every occurrence
+//   @split : ($s, ",") ~ xs;                a list of strings
+class StringEngine {
+private:
+    // A string parameter as a view: literals point into the instruction and string variables
+    // into their buffer, so nothing is copied. A char counts as a one-byte string.
+    static std::string_view pm_text(const str& item, SectionMemory& current_memory, const char* function_name, str& scratch) {
+        if (item.size() >= 2 && item.front() == '"' && item.back() == '"')
+            return std::string_view(item).substr(1, item.size() - 2);
+        if (item.size() > 1 && item.front() == '$')
+            if (const str* text = current_memory.m_findTyped<str>(item.substr(1)))
+                return *text;
+        value_t value = ListEngine::parseItem(item, current_memory, function_name);
+        if (value.second == ENUM_TYPE_CHAR)
+            scratch.assign(1, std::get<char>(value.first));
+        else if (value.second == ENUM_TYPE_STRING)
+            scratch = std::move(std::get<str>(value.first));
+        else
+            throw std::runtime_error(str("The parameters of ") + function_name + "() must be strings!");
+        return scratch;
+    }
+
+    static int64_t pm_integer(const str& item, SectionMemory& current_memory, const char* function_name) {
+        value_t value = ListEngine::parseItem(item, current_memory, function_name);
+        return std::visit([function_name](const auto& v) -> int64_t {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+                return static_cast<int64_t>(v);
+            else
+                throw std::runtime_error(str("The positions passed to ") + function_name + "() must be integers!");
+            }, value.first);
+    }
+
+    // Position of the first needle at or after from, or npos. Single bytes go through memchr and
+    // longer needles through memmem, which libc implements with vectorized two-way search.
+    static size_t pm_search(std::string_view haystack, std::string_view needle, size_t from = 0) {
+        if (from > haystack.size())
+            return std::string_view::npos;
+#if defined(_WIN32)
+        return haystack.find(needle, from);
+#else
+        if (needle.empty())
+            return from;
+        const char* begin = haystack.data() + from;
+        size_t length = haystack.size() - from;
+        const void* found = needle.size() == 1
+            ? std::memchr(begin, needle.front(), length)
+            : ::memmem(begin, length, needle.data(), needle.size());
+        return found ? static_cast<const char*>(found) - haystack.data() : std::string_view::npos;
+#endif
+    }
+
+    static void pm_storeString(SectionMemory& current_memory, const str& return_address, str&& text) {
+        if (return_address == "nullptr")
+            return;
+        if (str* slot = current_memory.m_findTyped<str>(return_address))
+            *slot = std::move(text);
+        else
+            current_memory.m_reInsertVariable(return_address, { std::move(text), ENUM_TYPE_STRING });
+    }
+
+    static void pm_storeBool(SectionMemory& current_memory, const str& return_address, bool value) {
+        if (return_address != "nullptr")
+            current_memory.m_reInsertVariable(return_address, { value, ENUM_TYPE_BOOL });
+    }
+
+public:
+    static void sb_new(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("sb_new() requires exactly one parameter! Syntax: (builder_name)");
+        current_memory.m_insertBuilder(parameters[0]);
+    }
+    static void sb_append(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.empty())
+            throw std::runtime_error("sb_append() requires a string builder! Syntax: (builder_name, items...)");
+        IOEngine::appendItems(current_memory.m_getBuilder(parameters[0]),
+            std::span<const str>(parameters).subspan(1), current_memory, false);
+    }
+    static void sb_finish(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 1)
+            throw std::runtime_error("sb_finish() requires exactly one parameter! Syntax: (builder_name) ~ string_name");
+        str text = std::move(current_memory.m_getBuilder(parameters[0]));
+        current_memory.m_removeBuilder(parameters[0]);
+        pm_storeString(current_memory, return_address, std::move(text));
+    }
+    static void find(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2 && parameters.size() != 3)
+            throw std::runtime_error("find() requires two or three parameters! Syntax: (string, needle, start) ~ i64_name");
+        str scratch_text, scratch_needle;
+        std::string_view text = pm_text(parameters[0], current_memory, "find", scratch_text);
+        std::string_view needle = pm_text(parameters[1], current_memory, "find", scratch_needle);
+        int64_t from = parameters.size() == 3 ? pm_integer(parameters[2], current_memory, "find") : 0;
+        if (from < 0)
+            throw std::runtime_error("The start passed to find() can't be negative!");
+        size_t at = pm_search(text, needle, static_cast<size_t>(from));
+        if (return_address != "nullptr")
+            current_memory.m_reInsertVariable(return_address,
+                { at == std::string_view::npos ? int64_t(-1) : static_cast<int64_t>(at), ENUM_TYPE_I64 });
+    }
+    static void contains(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2)
+            throw std::runtime_error("contains() requires two parameters! Syntax: (string, needle) ~ bool_name");
+        str scratch_text, scratch_needle;
+        std::string_view text = pm_text(parameters[0], current_memory, "contains", scratch_text);
+        std::string_view needle = pm_text(parameters[1], current_memory, "contains", scratch_needle);
+        pm_storeBool(current_memory, return_address, pm_search(text, needle) != std::string_view::npos);
+    }
+    static void starts_with(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2)
+            throw std::runtime_error("starts_with() requires two parameters! Syntax: (string, prefix) ~ bool_name");
+        str scratch_text, scratch_prefix;
+        std::string_view text = pm_text(parameters[0], current_memory, "starts_with", scratch_text);
+        std::string_view prefix = pm_text(parameters[1], current_memory, "starts_with", scratch_prefix);
+        pm_storeBool(current_memory, return_address, text.starts_with(prefix));
+    }
+    static void ends_with(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2)
+            throw std::runtime_error("ends_with() requires two parameters! Syntax: (string, suffix) ~ bool_name");
+        str scratch_text, scratch_suffix;
+        std::string_view text = pm_text(parameters[0], current_memory, "ends_with", scratch_text);
+        std::string_view suffix = pm_text(parameters[1], current_memory, "ends_with", scratch_suffix);
+        pm_storeBool(current_memory, return_address, text.ends_with(suffix));
+    }
+    static void substr(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2 && parameters.size() != 3)
+            throw std::runtime_error("substr() requires two or three parameters! Syntax: (string, start, length) ~ string_name");
+        str scratch;
+        std::string_view text = pm_text(parameters[0], current_memory, "substr", scratch);
+        int64_t start = pm_integer(parameters[1], current_memory, "substr");
+        int64_t length = parameters.size() == 3 ? pm_integer(parameters[2], current_memory, "substr") : INT64_MAX;
+        if (start < 0 || static_cast<uint64_t>(start) > text.size() || length < 0)
+            throw std::runtime_error("The start or length passed to substr() is out of range!");
+        pm_storeString(current_memory, return_address,
+            str(text.substr(static_cast<size_t>(start), static_cast<size_t>(std::min<uint64_t>(length, text.size())))));
+    }
+    static void replace(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 3)
+            throw std::runtime_error("replace() requires three parameters! Syntax: (string, from, to) ~ string_name");
+        str scratch_text, scratch_from, scratch_to;
+        std::string_view text = pm_text(parameters[0], current_memory, "replace", scratch_text);
+        std::string_view from = pm_text(parameters[1], current_memory, "replace", scratch_from);
+        std::string_view to = pm_text(parameters[2], current_memory, "replace", scratch_to);
+        if (from.empty())
+            throw std::runtime_error("replace() can't replace an empty string!");
+
+        str result;
+        size_t at = 0;
+        for (size_t found; (found = pm_search(text, from, at)) != std::string_view::npos; at = found + from.size()) {
+            if (result.empty())
+                result.reserve(text.size());
+            result.append(text, at, found - at);
+            result.append(to);
+        }
+        result.append(text, at);
+        pm_storeString(current_memory, return_address, std::move(result));
+    }
+    // The pieces between separators, including empty ones; a string without the separator
+    // gives a single element.
+    static void split(
+        const std::vector<str>& parameters,
+        const str& return_address,
+        SectionMemory& current_memory
+    ) {
+        if (parameters.size() != 2 || return_address == "nullptr")
+            throw std::runtime_error("split() requires two parameters! Syntax: (string, separator) ~ list_name");
+        str scratch_text, scratch_separator;
+        std::string_view text = pm_text(parameters[0], current_memory, "split", scratch_text);
+        std::string_view separator = pm_text(parameters[1], current_memory, "split", scratch_separator);
+        if (separator.empty())
+            throw std::runtime_error("split() needs a non-empty separator!");
+
+        std::vector<value_t> pieces;
+        size_t at = 0;
+        for (size_t found; (found = pm_search(text, separator, at)) != std::string_view::npos; at = found + separator.size())
+            pieces.emplace_back(str(text.substr(at, found - at)), ENUM_TYPE_STRING);
+        pieces.emplace_back(str(text.substr(at)), ENUM_TYPE_STRING);
+        ListEngine::storeList(current_memory, return_address, ListValue(std::move(pieces)));
+    }
+};
+#endif
@@ -7,6 +7,8 @@
 #define  ___STATIC__MEMBER___ static
 #define ___CONST___ const
 #define ___NO___EXCEPTION___ noexcept
+#define ___INLINE___THRESHOLD___ 12
+#define ___INLINE___MAX___ROUNDS___ 4
 #define ___OPERATOR__SET___ {',' , '!' ,'.'  , ':' , '@' , '(' , ')' , '{' , '}' , '[' , ']' , '$' , '-'  , '~' , '<' , '>', ';' , '"' , '_'}
 
 #ifndef ___HAS___DECLARED___TYPES___
@@ -16,6 +18,7 @@ typedef bool ___BOOLEAN___;
 typedef char ___CHAR___;
 typedef std::vector<std::string> ___STRING___VECTOR___;
 typedef robin_hood::unordered_set<char> ___CHAR___SET___;
+typedef robin_hood::unordered_set<std::string> ___STRING___SET___;
 typedef std::string ___STRING___;
 typedef robin_hood::unordered_map<std::string, std::string> ___UMAP___STRING___STRING___T___;
 typedef robin_hood::unordered_map<std::string, std::vector<std::string>> ___UMAP___STRING___VECTOR___STRING___T___;
@@ -360,10 +363,707 @@ public:
         return ___RESULT___;
     }
 
+    ___STATIC__MEMBER___ ___STRING___
+        ___M___MANGLE___INLINED___NAME___
+        (___CONST___ ___STRING___& ___SECTION___, ___CONST___ ___STRING___& ___NAME___)
+        ___NO___EXCEPTION___
+    {
+        return ___STRING___("___INLINE___") + ___SECTION___ + ___STRING___("___") + ___NAME___ + ___STRING___("___");
+    }
+
+    // Built-ins that create the name passed as their first parameter (the return address is
+    // always treated as created, see ___M___EXPAND___INLINED___SECTION___).
+    ___STATIC__MEMBER___ ___BOOLEAN___
+        ___M___CREATES___FIRST___PARAMETER___
+        (___CONST___ ___STRING___& ___TODO___)
+        ___NO___EXCEPTION___
+    {
+        static ___CONST___ ___STRING___SET___ ___CREATORS___ = {
+            "new_list", "reAssign_list", "new_dict", "sb_new", "range_list", "range", "list_load"
+        };
+        return ___TODO___.rfind("new_", 0) == 0 || ___CREATORS___.contains(___TODO___);
+    }
+
+    // Built-ins that create names derived from their return address (csv_read's <t>_<column>
+    // lists), which no write set can spell out. A loop containing one is left alone by the
+    // hoisting pass; register any new built-in of this kind here.
+    ___STATIC__MEMBER___ ___BOOLEAN___
+        ___M___CREATES___DERIVED___NAMES___
+        (___CONST___ ___STRING___& ___TODO___)
+        ___NO___EXCEPTION___
+    {
+        static ___CONST___ ___STRING___SET___ ___DERIVERS___ = { "csv_read" };
+        return ___DERIVERS___.contains(___TODO___);
+    }
+
+    // Built-ins whose parameters are plain values, $references or whole names, so renaming the
+    // callee's locals token by token is enough. Anything else (sections passed by name, names
+    // derived from others like csv_read's columns, unknown opcodes) keeps a section from being inlined.
+    ___STATIC__MEMBER___ ___BOOLEAN___
+        ___M___IS___INLINABLE___TODO___
+        (___CONST___ ___STRING___& ___TODO___)
+        ___NO___EXCEPTION___
+    {
+        static ___CONST___ ___STRING___SET___ ___INLINABLE___ = {
+            "delete_var", "print", "println", "flush", "input", "read_lines", "read_all",
+            "open", "read_line", "file_eof", "write", "writeln", "close",
+            "sb_append", "sb_finish", "find", "contains", "starts_with", "ends_with", "substr", "replace", "split",
+            "hash", "hash_list", "loop", "start", "end", "foreach", "foreach_line",
+            "delete_list", "get", "push", "pop", "list_size", "slice", "list_save", "sort",
+            "list_sum", "list_min", "list_max", "list_dot", "list_add", "list_mul", "list_scale", "print_list",
+            "delete_dict", "dict_set", "dict_get", "dict_has", "dict_erase", "dict_size", "dict_keys", "dict_values", "print_dict"
+        };
+        return ___M___IS___PURE___TODO___(___TODO___) ||
+            ___M___CREATES___FIRST___PARAMETER___(___TODO___) ||
+            ___TODO___.rfind("reAssign_", 0) == 0 ||
+            ___INLINABLE___.contains(___TODO___);
+    }
+
+    // True if a '$' appears anywhere but at the start of the token (after an optional '!'),
+    // e.g. inside a list literal; such references aren't renamed.
+    ___STATIC__MEMBER___ ___BOOLEAN___
+        ___M___HAS___EMBEDDED___REFERENCE___
+        (___CONST___ ___STRING___& ___TOKEN___)
+        ___NO___EXCEPTION___
+    {
+        size_t ___AT___ = (!___TOKEN___.empty() && ___TOKEN___[0] == '!') ? 1 : 0;
+        if (___AT___ < ___TOKEN___.size() && ___TOKEN___[___AT___] == '$')
+            ___AT___++;
+        return ___TOKEN___.find('$', ___AT___) != ___STRING___::npos;
+    }
+
+    ___STATIC__MEMBER___ ___BOOLEAN___
+        ___M___IS___INLINABLE___
+        (___CONST___ ___UMAP___STRING___VECTOR___INSTRUCTIONS___T___& ___CODE___,
+            ___CONST___ ___STRING___SET___& ___SHARED___SECTIONS___,
+            ___CONST___ ___STRING___& ___CALLER___,
+            ___CONST___ ___STRING___& ___CALLEE___)
+        ___NO___EXCEPTION___
+    {
+        if (___CALLEE___ == ___CALLER___ || !___CODE___.contains(___CALLEE___))
+            return false;
+
+        if (___SHARED___SECTIONS___.contains(___CALLEE___))
+            return false;
+
+        ___STRING___SET___ ___IMPORTED___;
+        ___STRING___SET___ ___EXPORTED___;
+        size_t ___BODY___SIZE___ = 0;
+
+        for (auto& item : ___CODE___.at(___CALLEE___))
+        {
+            if (item.___TODO___ == "execute" || item.___TODO___ == "goto" || item.___TODO___ == "destination")
+                return false;
+
+            if (item.___TODO___ == "import" || item.___TODO___ == "export")
+            {
+                if (item.___VM___WILL___EXECUTE___ != "true" ||
+                    item.___PARAMETERS___.empty() ||
+                    item.___PARAMETERS___[0] != ___CALLER___)
+                    return false;
+
+                auto& ___TARGET___ = item.___TODO___ == "import" ? ___IMPORTED___ : ___EXPORTED___;
+                for (size_t idx = 1; idx < item.___PARAMETERS___.size(); ++idx)
+                    ___TARGET___.insert(item.___PARAMETERS___[idx]);
+                continue;
+            }
+            if (!___M___IS___INLINABLE___TODO___(item.___TODO___) ||
+                ___M___HAS___EMBEDDED___REFERENCE___(item.___VM___WILL___EXECUTE___))
+                return false;
+            for (auto& __item : item.___PARAMETERS___)
+                if (___M___HAS___EMBEDDED___REFERENCE___(__item))
+                    return false;
+            ___BODY___SIZE___++;
+        }
+
+        if (___BODY___SIZE___ > ___INLINE___THRESHOLD___)
+            return false;
+
+        for (auto& item : ___IMPORTED___)
+            if (!___EXPORTED___.contains(item))
+                return false;
+
+        return true;
+    }
+
+    ___STATIC__MEMBER___ ___INSTRUCTIONS___VECTOR___T___
+        ___M___EXPAND___INLINED___SECTION___
+        (___CONST___ ___INSTRUCTIONS___VECTOR___T___& ___CALLEE___CODE___,
+            ___CONST___ ___STRING___& ___CALLEE___)
+        ___NO___EXCEPTION___
+    {
+        ___STRING___SET___ ___SHARED___;
+        ___STRING___SET___ ___LOCALS___;
+
+        for (auto& item : ___CALLEE___CODE___)
+        {
+            if (item.___TODO___ == "import" || item.___TODO___ == "export")
+            {
+                for (size_t idx = 1; idx < item.___PARAMETERS___.size(); ++idx)
+                    ___SHARED___.insert(item.___PARAMETERS___[idx]);
+                continue;
+            }
+            if (___M___CREATES___FIRST___PARAMETER___(item.___TODO___) && !item.___PARAMETERS___.empty())
+                ___LOCALS___.insert(item.___PARAMETERS___[0]);
+            if (item.___RETURN___ADDRESS___ != "nullptr")
+                ___LOCALS___.insert(item.___RETURN___ADDRESS___);
+        }
+
+        auto ___RENAME___ = [&](___CONST___ ___STRING___& ___NAME___) -> ___STRING___ {
+            if (___LOCALS___.contains(___NAME___) && !___SHARED___.contains(___NAME___))
+                return ___M___MANGLE___INLINED___NAME___(___CALLEE___, ___NAME___);
+            return ___NAME___;
+        };
+
+        auto ___RENAME___REFERENCE___ = [&](___CONST___ ___STRING___& ___TOKEN___) -> ___STRING___ {
+            size_t ___AT___ = 0;
+            if (___AT___ < ___TOKEN___.size() && ___TOKEN___[___AT___] == '!') ___AT___++;
+            if (___AT___ < ___TOKEN___.size() && ___TOKEN___[___AT___] == '$')
+                return ___TOKEN___.substr(0, ___AT___ + 1) + ___RENAME___(___TOKEN___.substr(___AT___ + 1));
+            return ___RENAME___(___TOKEN___);
+        };
+
+        ___INSTRUCTIONS___VECTOR___T___ ___RESULT___;
+        for (auto item : ___CALLEE___CODE___)
+        {
+            if (item.___TODO___ == "import" || item.___TODO___ == "export")
+                continue;
+
+            item.___VM___WILL___EXECUTE___ = ___RENAME___REFERENCE___(item.___VM___WILL___EXECUTE___);
+            item.___RETURN___ADDRESS___ = ___RENAME___(item.___RETURN___ADDRESS___);
+            for (auto& __item : item.___PARAMETERS___)
+                __item = ___RENAME___REFERENCE___(__item);
+
+            ___RESULT___.push_back(item);
+        }
+        return ___RESULT___;
+    }
+
+        ___STATIC__MEMBER___ void
+        ___M___INLINE___SECTIONS___
+        (___UMAP___STRING___VECTOR___INSTRUCTIONS___T___& ___CODE___)
+        ___NO___EXCEPTION___
+    {
+        ___STRING___SET___ ___SHARED___SECTIONS___;
+        for (auto& item : ___CODE___)
+            for (auto& __item : item.second)
+                if ((__item.___TODO___ == "import" || __item.___TODO___ == "export") &&
+                    !__item.___PARAMETERS___.empty())
+                    ___SHARED___SECTIONS___.insert(__item.___PARAMETERS___[0]);
+
+        ___BOOLEAN___ ___CHANGED___ = true;
+        for (int ___ROUND___ = 0; ___CHANGED___ && ___ROUND___ < ___INLINE___MAX___ROUNDS___; ++___ROUND___)
+        {
+            ___CHANGED___ = false;
+            for (auto& item : ___CODE___)
+            {
+                ___INSTRUCTIONS___VECTOR___T___ ___RESULT___;
+                for (auto& __item : item.second)
+                {
+                    if (__item.___TODO___ != "execute" || __item.___VM___WILL___EXECUTE___ != "true")
+                    {
+                        ___RESULT___.push_back(__item);
+                        continue;
+                    }
+
+                    ___BOOLEAN___ ___ANY___INLINED___ = false;
+                    for (auto& ___SECTION___ : __item.___PARAMETERS___)
+                        if (___M___IS___INLINABLE___(___CODE___, ___SHARED___SECTIONS___, item.first, ___SECTION___))
+                            ___ANY___INLINED___ = true;
+
+                    if (!___ANY___INLINED___)
+                    {
+                        ___RESULT___.push_back(__item);
+                        continue;
+                    }
+
+                    for (auto& ___SECTION___ : __item.___PARAMETERS___)
+                    {
+                        if (!___M___IS___INLINABLE___(___CODE___, ___SHARED___SECTIONS___, item.first, ___SECTION___))
+                        {
+                            ___INSTRUCTION___T___ ___CALL___ = __item;
+                            ___CALL___.___PARAMETERS___ = { ___SECTION___ };
+                            ___RESULT___.push_back(___CALL___);
+                            continue;
+                        }
+                        for (auto& ___INLINED___ : ___M___EXPAND___INLINED___SECTION___(___CODE___.at(___SECTION___), ___SECTION___))
+                            ___RESULT___.push_back(___INLINED___);
+                    }
+                    ___CHANGED___ = true;
+                }
+                item.second = ___RESULT___;
+            }
+        }
+    }
+
+    ___STATIC__MEMBER___ ___BOOLEAN___
+        ___M___IS___PURE___TODO___
+        (___CONST___ ___STRING___& ___TODO___)
+        ___NO___EXCEPTION___
+    {
+        static ___CONST___ ___STRING___SET___ ___PURE___ = {
+            "add", "sum", "multiply", "product", "subtract", "divide", "floor", "ceiling", "mod", "abs", "pow",
+            "isEqual", "isCharsEqual", "isGreater", "isLess", "isGreaterEqual", "isLessEqual", "isNotEqual", "isNotCharsEqual",
+            "reAssign_i8", "reAssign_i16", "reAssign_i32", "reAssign_i64", "reAssign_f32", "reAssign_f64", "reAssign_fmax",
+            "reAssign_str", "reAssign_char", "reAssign_bool", "get"
+        };
+        return ___PURE___.contains(___TODO___);
+    }
+
+    ___STATIC__MEMBER___ ___BOOLEAN___
+        ___M___IS___KNOWN___TODO___
+        (___CONST___ ___STRING___& ___TODO___)
+        ___NO___EXCEPTION___
+    {
+        static ___CONST___ ___STRING___SET___ ___KNOWN___ = {
+            "print", "println", "flush", "input", "print_list", "loop", "start", "end", "preheader",
+            "delete_var", "delete_list", "push", "pop"
+        };
+        return ___M___IS___PURE___TODO___(___TODO___) ||
+            ___KNOWN___.contains(___TODO___) ||
+            ___TODO___.rfind("new_", 0) == 0 ||
+            ___TODO___.rfind("reAssign_", 0) == 0;
+    }
+
+    ___STATIC__MEMBER___ ___BOOLEAN___
+        ___M___REFERENCED___NAME___
+        (___CONST___ ___STRING___& ___TOKEN___, ___STRING___& ___NAME___)
+        ___NO___EXCEPTION___
+    {
+        size_t ___AT___ = 0;
+        if (___AT___ < ___TOKEN___.size() && ___TOKEN___[___AT___] == '!') ___AT___++;
+        if (___AT___ >= ___TOKEN___.size() || ___TOKEN___[___AT___] != '$')
+            return false;
+        ___NAME___ = ___TOKEN___.substr(___AT___ + 1);
+        return true;
+    }
+
+    ___STATIC__MEMBER___ ___STRING___SET___
+        ___M___READ___SET___
+        (___CONST___ ___INSTRUCTION___T___& ___INS___)
+        ___NO___EXCEPTION___
+    {
+        ___STRING___SET___ ___RESULT___;
+        ___STRING___ ___NAME___;
+
+        if (___M___REFERENCED___NAME___(___INS___.___VM___WILL___EXECUTE___, ___NAME___))
+            ___RESULT___.insert(___NAME___);
+
+        ___BOOLEAN___ ___KNOWN___ = ___M___IS___KNOWN___TODO___(___INS___.___TODO___);
+        for (size_t idx = 0; idx < ___INS___.___PARAMETERS___.size(); ++idx)
+        {
+            ___CONST___ ___STRING___& item = ___INS___.___PARAMETERS___[idx];
+            if (___M___REFERENCED___NAME___(item, ___NAME___))
+                ___RESULT___.insert(___NAME___);
+            else if (!___KNOWN___ || (idx == 0 && ___INS___.___TODO___ == "get"))
+                ___RESULT___.insert(item);
+        }
+        return ___RESULT___;
+    }
+
+    ___STATIC__MEMBER___ ___STRING___SET___
+        ___M___WRITE___SET___
+        (___CONST___ ___INSTRUCTION___T___& ___INS___)
+        ___NO___EXCEPTION___
+    {
+        ___STRING___SET___ ___RESULT___;
+        ___CONST___ ___STRING___& ___TODO___ = ___INS___.___TODO___;
+        ___CONST___ ___STRING___VECTOR___& ___PARAMS___ = ___INS___.___PARAMETERS___;
+
+        if (___INS___.___RETURN___ADDRESS___ != "nullptr")
+            ___RESULT___.insert(___INS___.___RETURN___ADDRESS___);
+
+        if (!___M___IS___KNOWN___TODO___(___TODO___))
+        {
+            ___STRING___ ___NAME___;
+            for (auto& item : ___PARAMS___)
+                ___RESULT___.insert(___M___REFERENCED___NAME___(item, ___NAME___) ? ___NAME___ : item);
+            return ___RESULT___;
+        }
+
+        if (___PARAMS___.empty())
+            return ___RESULT___;
+
+        if (___TODO___ == "delete_var" || ___TODO___ == "delete_list")
+            for (auto& item : ___PARAMS___)
+                ___RESULT___.insert(item);
+
+        else if (___TODO___.rfind("new_", 0) == 0 || ___TODO___.rfind("reAssign_", 0) == 0 ||
+            ___TODO___ == "push" || ___TODO___ == "pop" || ___TODO___ == "start")
+            ___RESULT___.insert(___PARAMS___[0]);
+
+        return ___RESULT___;
+    }
+
+    ___STATIC__MEMBER___ ___BOOLEAN___
+        ___M___HOIST___ONE___INVARIANT___
+        (___INSTRUCTIONS___VECTOR___T___& ___CODE___)
+        ___NO___EXCEPTION___
+    {
+        for (size_t ___START___ = 0; ___START___ < ___CODE___.size(); ++___START___)
+        {
+            ___CONST___ ___INSTRUCTION___T___& ___HEAD___ = ___CODE___[___START___];
+            if (___HEAD___.___TODO___ != "start" ||
+                ___HEAD___.___PARAMETERS___.size() != 1 ||
+                ___HEAD___.___VM___WILL___EXECUTE___ != "true")
+                continue;
+
+            ___CONST___ ___STRING___ ___IDENTIFIER___ = ___HEAD___.___PARAMETERS___[0];
+            size_t ___END___ = ___START___ + 1;
+            while (___END___ < ___CODE___.size() &&
+                !(___CODE___[___END___].___TODO___ == "end" &&
+                    !___CODE___[___END___].___PARAMETERS___.empty() &&
+                    ___CODE___[___END___].___PARAMETERS___[0] == ___IDENTIFIER___))
+                ___END___++;
+            if (___END___ >= ___CODE___.size())
+                continue;
+
+            ___BOOLEAN___ ___OPAQUE___ = false;
+            robin_hood::unordered_map<std::string, int> ___WRITE___COUNT___;
+            ___WRITE___COUNT___[___IDENTIFIER___] += 2;
+
+            for (size_t idx = ___START___ + 1; idx < ___END___; ++idx)
+            {
+                ___CONST___ ___STRING___& ___TODO___ = ___CODE___[idx].___TODO___;
+                if (___TODO___ == "execute" || ___TODO___ == "import" || ___TODO___ == "export" ||
+                    ___TODO___ == "goto" || ___TODO___ == "destination" ||
+                    ___M___CREATES___DERIVED___NAMES___(___TODO___))
+                    ___OPAQUE___ = true;
+                for (auto& item : ___M___WRITE___SET___(___CODE___[idx]))
+                    ___WRITE___COUNT___[item]++;
+            }
+            if (___OPAQUE___)
+                continue;
+
+            ___STRING___SET___ ___READ___SO___FAR___;
+            std::vector<std::pair<std::string, ___BOOLEAN___>> ___NESTING___;
+
+            for (size_t idx = ___START___ + 1; idx < ___END___; ++idx)
+            {
+                ___CONST___ ___INSTRUCTION___T___& ___INS___ = ___CODE___[idx];
+                ___STRING___SET___ ___READS___ = ___M___READ___SET___(___INS___);
+                ___BOOLEAN___ ___AT___TOP___ = ___NESTING___.empty();
+
+                if (___INS___.___TODO___ == "preheader" && !___INS___.___PARAMETERS___.empty())
+                    ___NESTING___.push_back({ ___INS___.___PARAMETERS___[0], true });
+                else if (___INS___.___TODO___ == "start" && !___INS___.___PARAMETERS___.empty())
+                {
+                    if (!___NESTING___.empty() && ___NESTING___.back().second &&
+                        ___NESTING___.back().first == ___INS___.___PARAMETERS___[0])
+                        ___NESTING___.back().second = false;
+                    else
+                        ___NESTING___.push_back({ ___INS___.___PARAMETERS___[0], false });
+                }
+                else if (___INS___.___TODO___ == "foreach" || ___INS___.___TODO___ == "foreach_line")
+                    ___NESTING___.push_back({ ___INS___.___RETURN___ADDRESS___, false });
+                else if (___INS___.___TODO___ == "end" && !___INS___.___PARAMETERS___.empty() &&
+                    !___NESTING___.empty() && ___NESTING___.back().first == ___INS___.___PARAMETERS___[0])
+                    ___NESTING___.pop_back();
+
+                if (___AT___TOP___ && ___M___IS___PURE___TODO___(___INS___.___TODO___))
+                {
+                    ___STRING___SET___ ___WRITES___ = ___M___WRITE___SET___(___INS___);
+                    ___BOOLEAN___ ___INVARIANT___ = ___WRITES___.size() == 1;
+
+                    for (auto& item : ___WRITES___)
+                        if (___WRITE___COUNT___[item] != 1 || ___READ___SO___FAR___.contains(item) || ___READS___.contains(item))
+                            ___INVARIANT___ = false;
+
+                    for (auto& item : ___READS___)
+                        if (___WRITE___COUNT___.contains(item) && ___WRITE___COUNT___[item] > 0)
+                            ___INVARIANT___ = false;
+
+                    if (___INVARIANT___)
+                    {
+                        ___INSTRUCTION___T___ ___HOISTED___ = ___INS___;
+                        ___CODE___.erase(___CODE___.begin() + idx);
+
+                        ___BOOLEAN___ ___HAS___PREHEADER___ = false;
+                        for (size_t back = ___START___; back-- > 0;)
+                        {
+                            ___CONST___ ___INSTRUCTION___T___& ___PREV___ = ___CODE___[back];
+                            if (___PREV___.___TODO___ == "preheader" && !___PREV___.___PARAMETERS___.empty() &&
+                                ___PREV___.___PARAMETERS___[0] == ___IDENTIFIER___)
+                            {
+                                ___HAS___PREHEADER___ = true;
+                                break;
+                            }
+                            if (!___M___IS___PURE___TODO___(___PREV___.___TODO___))
+                                break;
+                        }
+
+                        if (!___HAS___PREHEADER___)
+                        {
+                            ___INSTRUCTION___T___ ___PREHEADER___;
+                            ___PREHEADER___.___TODO___ = "preheader";
+                            ___PREHEADER___.___PARAMETERS___ = { ___IDENTIFIER___ };
+                            ___CODE___.insert(___CODE___.begin() + ___START___, ___PREHEADER___);
+                            ___START___++;
+                        }
+                        ___CODE___.insert(___CODE___.begin() + ___START___, ___HOISTED___);
+                        return true;
+                    }
+                }
+
+                for (auto& item : ___READS___)
+                    ___READ___SO___FAR___.insert(item);
+            }
+        }
+        return false;
+    }
+
+        ___STATIC__MEMBER___ void
+        ___M___HOIST___LOOP___INVARIANTS___
+        (___UMAP___STRING___VECTOR___INSTRUCTIONS___T___& ___CODE___)
+        ___NO___EXCEPTION___
+    {
+        for (auto& item : ___CODE___)
+        {
+            size_t ___BUDGET___ = item.second.size();
+            while (___BUDGET___-- > 0 && ___M___HOIST___ONE___INVARIANT___(item.second)) {}
+        }
+    }
+
+    ___STATIC__MEMBER___ ___BOOLEAN___
+        ___M___IS___NUMERIC___LITERAL___
+        (___CONST___ ___STRING___& ___TOKEN___)
+        ___NO___EXCEPTION___
+    {
+        size_t ___AT___ = (!___TOKEN___.empty() && (___TOKEN___[0] == '-' || ___TOKEN___[0] == '+')) ? 1 : 0;
+        ___BOOLEAN___ ___HAS___DIGIT___ = false;
+        ___BOOLEAN___ ___HAS___DOT___ = false;
+        for (; ___AT___ < ___TOKEN___.size(); ++___AT___)
+        {
+            if (std::isdigit(static_cast<unsigned char>(___TOKEN___[___AT___])))
+                ___HAS___DIGIT___ = true;
+            else if (___TOKEN___[___AT___] == '.' && !___HAS___DOT___)
+                ___HAS___DOT___ = true;
+            else
+                return false;
+        }
+        return ___HAS___DIGIT___;
+    }
+
+    // The result type of an opcode written by ___M___SPECIALIZE___ARITHMETIC___, such as i64 for
+    // add_i64_c_to_i64, or an empty string for any other opcode. Such an opcode only writes its
+    // return address, and always with that type.
+    ___STATIC__MEMBER___ ___STRING___
+        ___M___SPECIALIZED___TYPE___
+        (___CONST___ ___STRING___& ___TODO___)
+        ___NO___EXCEPTION___
+    {
+        static ___CONST___ ___STRING___SET___ ___OPERATIONS___ = {
+            "add", "multiply", "subtract", "divide", "mod", "pow", "floor", "ceiling", "abs"
+        };
+        size_t ___TO___ = ___TODO___.rfind("_to_");
+        size_t ___FIRST___ = ___TODO___.find('_');
+        if (___TO___ == ___STRING___::npos || ___FIRST___ >= ___TO___ ||
+            !___OPERATIONS___.contains(___TODO___.substr(0, ___FIRST___)))
+            return "";
+        ___STRING___ ___TYPE___ = ___TODO___.substr(___TO___ + 4);
+        ___STRING___ ___OPERANDS___ = ___TODO___.substr(___FIRST___, ___TO___ - ___FIRST___) + "_";
+        for (size_t ___AT___ = 0; ___AT___ + 1 < ___OPERANDS___.size();)
+        {
+            size_t ___NEXT___ = ___OPERANDS___.find('_', ___AT___ + 1);
+            ___STRING___ ___OPERAND___ = ___OPERANDS___.substr(___AT___ + 1, ___NEXT___ - ___AT___ - 1);
+            if (___OPERAND___ != "c" && ___OPERAND___ != ___TYPE___)
+                return "";
+            ___AT___ = ___NEXT___;
+        }
+        return ___TYPE___;
+    }
+
+    ___STATIC__MEMBER___ ___UMAP___STRING___STRING___T___
+        ___M___INFER___TYPES___
+        (___CONST___ ___INSTRUCTIONS___VECTOR___T___& ___CODE___)
+        ___NO___EXCEPTION___
+    {
+        ___UMAP___STRING___STRING___T___ ___RESULT___;
+        auto ___NOTE___ = [&___RESULT___](___CONST___ ___STRING___& ___NAME___, ___CONST___ ___STRING___& ___TYPE___) {
+            auto ___FOUND___ = ___RESULT___.find(___NAME___);
+            if (___FOUND___ == ___RESULT___.end())
+                ___RESULT___.emplace(___NAME___, ___TYPE___);
+            else if (___FOUND___->second != ___TYPE___)
+                ___FOUND___->second = "?";
+        };
+
+        for (auto& item : ___CODE___)
+        {
+            ___CONST___ ___STRING___& ___TODO___ = item.___TODO___;
+
+            ___STRING___ ___SPECIALIZED___ = ___M___SPECIALIZED___TYPE___(___TODO___);
+            if (!___SPECIALIZED___.empty())
+            {
+                ___NOTE___(item.___RETURN___ADDRESS___, ___SPECIALIZED___);
+                continue;
+            }
+
+            if ((___TODO___.rfind("new_", 0) == 0 || ___TODO___.rfind("reAssign_", 0) == 0) && !item.___PARAMETERS___.empty())
+                ___NOTE___(item.___PARAMETERS___[0], ___TODO___.substr(___TODO___.find('_') + 1));
+            else if (___TODO___ == "import")
+                for (size_t idx = 1; idx < item.___PARAMETERS___.size(); ++idx)
+                    ___NOTE___(item.___PARAMETERS___[idx], "?");
+            else if (!___M___IS___KNOWN___TODO___(___TODO___))
+                for (auto& __item : ___M___WRITE___SET___(item))
+                    ___NOTE___(__item, "?");
+
+            if (item.___RETURN___ADDRESS___ != "nullptr" &&
+                (!___M___IS___PURE___TODO___(___TODO___) || ___TODO___ == "get") && ___TODO___ != "loop")
+                ___NOTE___(item.___RETURN___ADDRESS___, "?");
+        }
+        return ___RESULT___;
+    }
+
+    ___STATIC__MEMBER___ void
+        ___M___SPECIALIZE___ARITHMETIC___
+        (___UMAP___STRING___VECTOR___INSTRUCTIONS___T___& ___CODE___)
+        ___NO___EXCEPTION___
+    {
+        static ___CONST___ ___UMAP___STRING___STRING___T___ ___OPCODES___ = {
+            {"add", "add"}, {"sum", "add"}, {"multiply", "multiply"}, {"product", "multiply"},
+            {"subtract", "subtract"}, {"divide", "divide"}, {"mod", "mod"}, {"pow", "pow"},
+            {"floor", "floor"}, {"ceiling", "ceiling"}, {"abs", "abs"}
+        };
+        static ___CONST___ ___STRING___SET___ ___NUMERIC___ = { "i8", "i16", "i32", "i64", "f32", "f64", "fmax" };
+
+        for (auto& item : ___CODE___)
+        {
+            ___UMAP___STRING___STRING___T___ ___TYPES___ = ___M___INFER___TYPES___(item.second);
+            ___STRING___VECTOR___ ___ITERATORS___;
+
+            for (auto& __item : item.second)
+            {
+                if (__item.___TODO___ == "start" && !__item.___PARAMETERS___.empty())
+                    ___ITERATORS___.push_back(__item.___PARAMETERS___[0]);
+                else if (__item.___TODO___ == "end" && !___ITERATORS___.empty() &&
+                    !__item.___PARAMETERS___.empty() && ___ITERATORS___.back() == __item.___PARAMETERS___[0])
+                    ___ITERATORS___.pop_back();
+
+                auto ___OPCODE___ = ___OPCODES___.find(__item.___TODO___);
+                if (___OPCODE___ == ___OPCODES___.end())
+                    continue;
+
+                ___BOOLEAN___ ___UNARY___ = ___OPCODE___->second == "floor" ||
+                    ___OPCODE___->second == "ceiling" || ___OPCODE___->second == "abs";
+                if (__item.___PARAMETERS___.size() != (___UNARY___ ? 1u : 2u))
+                    continue;
+
+                auto ___TYPE___OF___ = [&](___CONST___ ___STRING___& ___NAME___) -> ___STRING___ {
+                    for (auto& ___ITERATOR___ : ___ITERATORS___)
+                        if (___ITERATOR___ == ___NAME___)
+                            return "i64";
+                    auto ___FOUND___ = ___TYPES___.find(___NAME___);
+                    if (___FOUND___ == ___TYPES___.end() || !___NUMERIC___.contains(___FOUND___->second))
+                        return "?";
+                    return ___FOUND___->second;
+                };
+
+                ___STRING___ ___RETURN___TYPE___ = ___TYPE___OF___(__item.___RETURN___ADDRESS___);
+                if (___RETURN___TYPE___ == "?")
+                    continue;
+
+                ___STRING___ ___NAME___ = ___OPCODE___->second;
+                ___STRING___VECTOR___ ___OPERANDS___;
+                ___BOOLEAN___ ___ALL___LITERALS___ = true;
+                ___BOOLEAN___ ___KNOWN___ = true;
+
+                for (auto& ___TOKEN___ : __item.___PARAMETERS___)
+                {
+                    if (___M___IS___NUMERIC___LITERAL___(___TOKEN___))
+                    {
+                        // integer kernels compute in int64_t, so a fractional literal keeps the generic path
+                        if (___RETURN___TYPE___[0] == 'i' && ___TOKEN___.find('.') != ___STRING___::npos)
+                        {
+                            ___KNOWN___ = false;
+                            break;
+                        }
+                        ___NAME___ += "_c";
+                        ___OPERANDS___.push_back(___TOKEN___);
+                        continue;
+                    }
+                    ___STRING___ ___TYPE___ = ___TOKEN___.size() > 1 && ___TOKEN___[0] == '$' ? ___TYPE___OF___(___TOKEN___.substr(1)) : "?";
+                    if (___TYPE___ != ___RETURN___TYPE___)
+                    {
+                        ___KNOWN___ = false;
+                        break;
+                    }
+                    ___ALL___LITERALS___ = false;
+                    ___NAME___ += "_" + ___TYPE___;
+                    ___OPERANDS___.push_back(___TOKEN___.substr(1));
+                }
+
+                if (!___KNOWN___ || ___ALL___LITERALS___)
+                    continue;
+
+                __item.___TODO___ = ___NAME___ + "_to_" + ___RETURN___TYPE___;
+                __item.___PARAMETERS___ = ___OPERANDS___;
+            }
+        }
+    }
+
+    // Turns @print and @println into print_fmt_<slots>: literal parameters lose their quotes and are
+    // merged (println's line breaks included), variables lose their '$'. Each slot is c for a
+    // literal, the variable's type where it is known, or v. IOEngine::formatUtility builds the kernel.
+    ___STATIC__MEMBER___ void
+        ___M___PLAN___PRINTS___
+        (___UMAP___STRING___VECTOR___INSTRUCTIONS___T___& ___CODE___)
+        ___NO___EXCEPTION___
+    {
+        static ___CONST___ ___STRING___SET___ ___TYPED___ = { "i8", "i16", "i32", "i64", "f32", "f64", "fmax", "bool", "char", "str" };
+
+        for (auto& item : ___CODE___)
+        {
+            ___UMAP___STRING___STRING___T___ ___TYPES___ = ___M___INFER___TYPES___(item.second);
+
+            for (auto& __item : item.second)
+            {
+                ___BOOLEAN___ ___LINES___ = __item.___TODO___ == "println";
+                if ((!___LINES___ && __item.___TODO___ != "print") || __item.___PARAMETERS___.empty())
+                    continue;
+
+                ___STRING___ ___NAME___ = "print_fmt";
+                ___STRING___VECTOR___ ___SLOTS___;
+                ___BOOLEAN___ ___OPEN___LITERAL___ = false;
+                auto ___LITERAL___ = [&](___CONST___ ___STRING___& ___TEXT___, size_t ___FROM___, size_t ___COUNT___) {
+                    if (!___OPEN___LITERAL___)
+                    {
+                        ___NAME___ += "_c";
+                        ___SLOTS___.emplace_back();
+                        ___OPEN___LITERAL___ = true;
+                    }
+                    ___SLOTS___.back().append(___TEXT___, ___FROM___, ___COUNT___);
+                };
+
+                for (auto& ___TOKEN___ : __item.___PARAMETERS___)
+                {
+                    if (!___TOKEN___.empty() && ___TOKEN___[0] == '$')
+                    {
+                        ___STRING___ ___VARIABLE___ = ___TOKEN___.substr(1);
+                        auto ___FOUND___ = ___TYPES___.find(___VARIABLE___);
+                        ___NAME___ += "_" + (___FOUND___ != ___TYPES___.end() && ___TYPED___.contains(___FOUND___->second) ? ___FOUND___->second : "v");
+                        ___SLOTS___.push_back(std::move(___VARIABLE___));
+                        ___OPEN___LITERAL___ = false;
+                    }
+                    else if (___TOKEN___.size() >= 2 && ___TOKEN___.front() == '"' && ___TOKEN___.back() == '"')
+                        ___LITERAL___(___TOKEN___, 1, ___TOKEN___.size() - 2);
+                    else
+                        ___LITERAL___(___TOKEN___, 0, ___TOKEN___.size());
+
+                    if (___LINES___)
+                        ___LITERAL___("\n", 0, 1);
+                }
+
+                __item.___TODO___ = ___NAME___;
+                __item.___PARAMETERS___ = std::move(___SLOTS___);
+            }
+        }
+    }
+
         ___STATIC__MEMBER___ ___UMAP___STRING___VECTOR___INSTRUCTIONS___T___
         ___M___COMPILE___
         (___CONST___ ___STRING___& ___CODE___,
-            ___CONST___ ___BOOLEAN___ ___GIVE___STATUS___ = false
+            ___CONST___ ___BOOLEAN___ ___GIVE___STATUS___ = false,
+            ___CONST___ ___BOOLEAN___ ___OPTIMIZE___ = true
         )
         ___NO___EXCEPTION___
     {
@@ -373,6 +1073,14 @@ public:
         (DICC_Compiler::___M___EXTRACT___PROGRAMS___(___CODE___))
         );
 
+    if (___OPTIMIZE___)
+    {
+        DICC_Compiler::___M___INLINE___SECTIONS___(___RESULT___);
+        DICC_Compiler::___M___HOIST___LOOP___INVARIANTS___(___RESULT___);
+        DICC_Compiler::___M___SPECIALIZE___ARITHMETIC___(___RESULT___);
+        DICC_Compiler::___M___PLAN___PRINTS___(___RESULT___);
+    }
+
     if (___GIVE___STATUS___) {
     for (auto item : ___RESULT___) {
         std::cout << "|===============================================|" << "\n\n";
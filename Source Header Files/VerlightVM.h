@@ -11,11 +11,23 @@
 #         include "RelationalEngine.h"
 #         include "LoopEngine.h"
 #         include "ListEngine.h"
+#         include "DictEngine.h"
+#         include "Parallel.h"
+#         include "AsyncSink.h"
+#         include "CsvEngine.h"
+#         include "FileEngine.h"
+#         include "StringEngine.h"
+#         include "HashEngine.h"
 #endif
 
 
 class  VerlightVM {
 private:
+	// Everything the program prints goes through here; see OutputBuffer.
+	OutputBuffer output_buffer;
+	// What @input reads from; std::cin unless the host supplies something else.
+	std::shared_ptr<InputSource> input_source = std::make_shared<StreamSource>(std::cin);
+
 	robin_hood::unordered_map
 		<str, std::function<void(std::vector<str>&, str&, SectionMemory&)>>
 		all_utilities =
@@ -48,6 +60,29 @@ private:
 		{"println" , IOEngine::println},
 		{"flush" , IOEngine::flush},
 		{"input" , IOEngine::input},
+		{"read_lines" , IOEngine::read_lines},
+		{"read_all" , IOEngine::read_all},
+
+		{"open" , FileEngine::open},
+		{"read_line" , FileEngine::read_line},
+		{"file_eof" , FileEngine::file_eof},
+		{"write" , FileEngine::write},
+		{"writeln" , FileEngine::writeln},
+		{"close" , FileEngine::close},
+
+		{"sb_new" , StringEngine::sb_new},
+		{"sb_append" , StringEngine::sb_append},
+		{"sb_finish" , StringEngine::sb_finish},
+		{"find" , StringEngine::find},
+		{"contains" , StringEngine::contains},
+		{"starts_with" , StringEngine::starts_with},
+		{"ends_with" , StringEngine::ends_with},
+		{"substr" , StringEngine::substr},
+		{"replace" , StringEngine::replace},
+		{"split" , StringEngine::split},
+
+		{"hash" , HashEngine::hash},
+		{"hash_list" , HashEngine::hash_list},
 
 		{"add" , ArithmeticEngine::sum},
 		{"sum" , ArithmeticEngine::sum},
@@ -78,7 +113,40 @@ private:
 		{"get" , ListEngine::get},
 		{"push" , ListEngine::push},
 		{"pop" , ListEngine::pop},
-		{"print_list" , ListEngine::printList }
+		{"list_size" , ListEngine::list_size},
+		{"slice" , ListEngine::slice},
+		{"range_list" , ListEngine::range_list},
+		{"range" , ListEngine::range},
+		{"list_load" , ListEngine::list_load},
+		{"list_save" , ListEngine::list_save},
+		{"sort" , ListEngine::sort},
+		{"list_sum" , ListEngine::list_sum},
+		{"list_min" , ListEngine::list_min},
+		{"list_max" , ListEngine::list_max},
+		{"list_dot" , ListEngine::list_dot},
+		{"list_add" , ListEngine::list_add},
+		{"list_mul" , ListEngine::list_mul},
+		{"list_scale" , ListEngine::list_scale},
+		{"print_list" , ListEngine::printList },
+
+		{"new_dict" , DictEngine::new_dict},
+		{"delete_dict" , DictEngine::delete_dict},
+		{"dict_set" , DictEngine::dict_set},
+		{"dict_get" , DictEngine::dict_get},
+		{"dict_has" , DictEngine::dict_has},
+		{"dict_erase" , DictEngine::dict_erase},
+		{"dict_size" , DictEngine::dict_size},
+		{"dict_keys" , DictEngine::dict_keys},
+		{"dict_values" , DictEngine::dict_values},
+		{"print_dict" , DictEngine::printDict },
+
+		{"csv_read" , CsvEngine::csv_read }
+	};
+
+	// Utilities whose return address names a list, created on demand, rather than a variable.
+	robin_hood::unordered_flat_set<str> list_returning_utilities = {
+		"list_add", "list_mul", "list_scale", "slice", "dict_keys", "dict_values", "map", "filter",
+		"csv_read", "read_lines", "open", "split", "hash_list"
 	};
 
 
@@ -105,6 +173,39 @@ private:
 		throw std::runtime_error("missing matching 'end' for @start " + identifier);
 	}
 
+	// Index of the @end closing the block opened at openIdx, matched by identifier.
+	int64_t pm_findMatchingEnd(const std::vector<___INSTRUCTION___T___>& code, int64_t openIdx, const str& identifier)
+	{
+		for (int64_t idx = openIdx + 1; idx < static_cast<int64_t>(code.size()); ++idx) {
+			const auto& ins = code[idx];
+			if (ins.___TODO___ == "end" &&
+				!ins.___PARAMETERS___.empty() &&
+				ins.___PARAMETERS___[0] == identifier)
+				return idx;
+		}
+		throw std::runtime_error("missing matching 'end' for @" + code[openIdx].___TODO___ + " " + identifier);
+	}
+
+	void pm_readLoopBounds(SectionMemory& memory, const str& identifier,
+		int64_t& loop_start, int64_t& loop_stop, int64_t& loop_step)
+	{
+		str start_name = str("___LOOP___ENGINE___") + identifier + str("___start___");
+		str stop_name = str("___LOOP___ENGINE___") + identifier + str("___stop___");
+		str step_name = str("___LOOP___ENGINE___") + identifier + str("___step___");
+
+		if (!memory.m_containsVariable(start_name) ||
+			!memory.m_containsVariable(stop_name) ||
+			!memory.m_containsVariable(step_name))
+			throw std::runtime_error("Can't find the value of start or stop or step in the section buffer!");
+
+		loop_start = memory.m_fetchInteger(start_name);
+		loop_stop = memory.m_fetchInteger(stop_name);
+		loop_step = memory.m_fetchInteger(step_name);
+
+		if (loop_step == 0)
+			throw std::runtime_error("Loop step cannot be zero");
+	}
+
 public:
 	___UMAP___STRING___VECTOR___INSTRUCTIONS___T___ compiledCode;
 
@@ -112,11 +213,21 @@ public:
 
 	VerlightVM(___UMAP___STRING___VECTOR___INSTRUCTIONS___T___& compiledCode) :
 		compiledCode(compiledCode) {
+		for (auto& name_instructions : this->compiledCode)
+			for (auto& ins : name_instructions.second)
+				if (!all_utilities.contains(ins.___TODO___)) {
+					if (auto specialized = ArithmeticEngine::specializedUtility(ins.___TODO___))
+						all_utilities.emplace(ins.___TODO___, specialized);
+					else if (auto format = IOEngine::formatUtility(ins.___TODO___))
+						all_utilities.emplace(ins.___TODO___, std::move(format));
+				}
 	};
 
 	void buildMemory() {
 		for (auto name_instructions : compiledCode) {
 			SectionMemory newMemory;
+			newMemory.m_setOutput(&output_buffer);
+			newMemory.m_setInput(input_source.get());
 			memoryUnion.insert({ name_instructions.first , newMemory });
 		}
 	}
@@ -140,8 +251,53 @@ public:
 			("Can't find the program name in memoryUnion. Use buildMemory() if you haven't drawn the blueprint");
 		}
 
-		auto& base_instructions = compiledCode[programName];
-		SectionMemory& base_memory = memoryUnion[programName];
+		try {
+			pm_run(programName, memoryUnion[programName], startIdx, endIdx);
+		}
+		catch (...) {
+			output_buffer.flush();
+			throw;
+		}
+		output_buffer.flush();
+	}
+
+	// The program's output buffer, e.g. to switch line buffering on or off.
+	OutputBuffer& output() { return output_buffer; }
+
+	// Sends the program's output somewhere other than stdout, e.g. a MemorySink whose
+	// view() holds everything printed once execute() returns.
+	void setOutput(std::shared_ptr<OutputSink> sink) {
+		if (!sink)
+			throw std::runtime_error("The output sink can't be null!");
+		output_buffer.setSink(std::move(sink));
+	}
+
+	// Moves writing the output onto a background thread, see AsyncSink. The current sink
+	// (stdout unless setOutput() was called) stays the final destination.
+	void setAsyncOutput(size_t capacity = 1 << 22) {
+		output_buffer.setSink(std::make_shared<AsyncSink>(output_buffer.getSink(), capacity));
+	}
+
+	// Makes @input read from the given source instead of std::cin.
+	void setInput(std::shared_ptr<InputSource> source) {
+		if (!source)
+			throw std::runtime_error("The input source can't be null!");
+		input_source = std::move(source);
+		for (auto& memory : memoryUnion)
+			memory.second.m_setInput(input_source.get());
+	}
+
+private:
+	// True on threads currently running a section for @map, @filter or @reduce;
+	// nested uses of those on such a thread run sequentially.
+	static inline thread_local bool pm_inWorker = false;
+
+	// Runs instructions [startIdx, endIdx] of a section against the given memory frame.
+	void pm_run(const str& programName, SectionMemory& base_memory,
+		int64_t startIdx = 0,
+		int64_t endIdx = -1)
+	{
+		auto& base_instructions = compiledCode.find(programName)->second;
 		int64_t size = static_cast<int64_t>(base_instructions.size());
 
 		if (endIdx == -1) endIdx = size - 1;
@@ -169,7 +325,8 @@ public:
 
 			auto& return_address = currentIns.___RETURN___ADDRESS___;
 
-			if (!base_memory.m_containsVariable(return_address) && return_address != "nullptr")
+			if (!base_memory.m_containsVariable(return_address) && return_address != "nullptr" &&
+				!list_returning_utilities.contains(currentIns.___TODO___))
 			{
 				std::cerr << "\n[ERROR_ENGINE] The return_address that is causing exception is: ("
 					<< return_address << ")\n";
@@ -188,30 +345,97 @@ public:
 				std::vector<___INSTRUCTION___T___> temp = pm_selectStartEndCode(base_instructions, idx);
 				uint64_t loop_end_idx = idx - 1;
 
-				str start_name = str("___LOOP___ENGINE___") + identifier + str("___start___");
-				str stop_name = str("___LOOP___ENGINE___") + identifier + str("___stop___");
-				str step_name = str("___LOOP___ENGINE___") + identifier + str("___step___");
-
-				if (!base_memory.m_containsVariable(start_name) ||
-					!base_memory.m_containsVariable(stop_name) ||
-					!base_memory.m_containsVariable(step_name))
-					throw std::runtime_error("Can't find the value of start or stop or step in the section buffer!");
-
-				int64_t loop_start = std::stoll(makeValueToString(base_memory.m_getVariable(start_name)));
-				int64_t loop_stop = std::stoll(makeValueToString(base_memory.m_getVariable(stop_name)));
-				int64_t loop_step = std::stoll(makeValueToString(base_memory.m_getVariable(step_name)));
-
-				if (loop_step == 0)
-					throw std::runtime_error("Loop step cannot be zero");
+				int64_t loop_start, loop_stop, loop_step;
+				pm_readLoopBounds(base_memory, identifier, loop_start, loop_stop, loop_step);
 
 				for (int64_t iterator = loop_start; iterator <= loop_stop; iterator += loop_step) {
 					base_memory.m_reInsertVariable(identifier, { iterator , ENUM_TYPE_I64 });
-					execute(programName, loop_start_idx, loop_end_idx);
+					pm_run(programName, base_memory, loop_start_idx, loop_end_idx);
 				}
 				idx = static_cast<int64_t>(loop_end_idx + 1);
 				continue;
 			}
 
+			else if (currentIns.___TODO___ == "foreach") {
+
+				if (currentIns.___PARAMETERS___.size() != 1 || return_address == "nullptr")
+					throw std::runtime_error("@foreach requires a list and an item variable! Syntax: @foreach : (list_name) ~ item; ... @end : (item);");
+
+				int64_t body_start_idx = idx + 1;
+				int64_t end_idx = pm_findMatchingEnd(base_instructions, idx, return_address);
+
+				// Iterate over a snapshot: it shares the list's storage, and if the body modifies
+				// the list, copy-on-write leaves the elements being traversed untouched.
+				const ListValue items = base_memory.m_getList(currentIns.___PARAMETERS___[0]);
+				if (items.m_isRange()) {
+					for (size_t position = 0; position < items.m_size(); ++position) {
+						base_memory.m_reInsertVariable(return_address, items.m_at(position));
+						pm_run(programName, base_memory, body_start_idx, end_idx - 1);
+					}
+				}
+				else {
+					items.m_visit([&](auto values) {
+						using T = typename decltype(values)::value_type;
+						for (const T& value : values) {
+							if constexpr (std::is_same_v<T, value_t>)
+								base_memory.m_reInsertVariable(return_address, value);
+							else
+								base_memory.m_reInsertVariable(return_address, { value, ListValue::m_typeOf<T>() });
+							pm_run(programName, base_memory, body_start_idx, end_idx - 1);
+						}
+						});
+				}
+				idx = end_idx;
+				continue;
+			}
+
+			else if (currentIns.___TODO___ == "foreach_line") {
+
+				if (currentIns.___PARAMETERS___.size() != 1 || return_address == "nullptr")
+					throw std::runtime_error("@foreach_line requires a file and a line variable! Syntax: @foreach_line : (file_name) ~ line; ... @end : (line);");
+
+				int64_t body_start_idx = idx + 1;
+				int64_t end_idx = pm_findMatchingEnd(base_instructions, idx, return_address);
+
+				// Held here so the body may close the file; the loop then simply stops.
+				std::shared_ptr<FileHandle> file = base_memory.m_shareFile(currentIns.___PARAMETERS___[0]);
+				if (!file->isReadable())
+					throw std::runtime_error("@foreach_line needs a file opened with \"r\"!");
+				std::string_view line;
+				while (file->nextLine(line)) {
+					FileEngine::storeLine(base_memory, return_address, line);
+					pm_run(programName, base_memory, body_start_idx, end_idx - 1);
+				}
+				idx = end_idx;
+				continue;
+			}
+
+			else if (currentIns.___TODO___ == "map" || currentIns.___TODO___ == "filter" ||
+				currentIns.___TODO___ == "reduce") {
+				pm_applySection(currentIns, base_memory);
+				continue;
+			}
+
+			else if (currentIns.___TODO___ == "preheader") {
+
+				if (currentIns.___PARAMETERS___.size() != 1)
+					throw std::runtime_error("Parameters for @preheader : () requires a single parameter (iterator_name)!");
+
+				// Code hoisted out of a loop only runs if that loop runs at least once.
+				str identifier = currentIns.___PARAMETERS___[0];
+				int64_t loop_start, loop_stop, loop_step;
+				pm_readLoopBounds(base_memory, identifier, loop_start, loop_stop, loop_step);
+				if (loop_start <= loop_stop)
+					continue;
+
+				while (idx + 1 <= endIdx &&
+					!(base_instructions[idx + 1].___TODO___ == "start" &&
+						!base_instructions[idx + 1].___PARAMETERS___.empty() &&
+						base_instructions[idx + 1].___PARAMETERS___[0] == identifier))
+					idx++;
+				continue;
+			}
+
 			else if (currentIns.___TODO___ == "import")
 			{
 				auto& parameters = currentIns.___PARAMETERS___;
@@ -239,14 +463,16 @@ public:
 
 					str& currentVar_name = parameters[index];
 
-					if (!fromMemory.m_containsVariable(currentVar_name))
+					if (!fromMemory.m_containsVariable(currentVar_name) && !fromMemory.m_containsList(currentVar_name) &&
+						!fromMemory.m_containsDict(currentVar_name))
 					{
 						std::cerr << "\n[ERROR_ENGINE] The currentVar_name that is causing exception is: ("
 							<< currentVar_name << ")\n";
 						throw std::runtime_error
 						("Can't find the variable!");
 					}
-					if (base_memory.m_containsVariable(currentVar_name))
+					if (base_memory.m_containsVariable(currentVar_name) || base_memory.m_containsList(currentVar_name) ||
+						base_memory.m_containsDict(currentVar_name))
 					{
 						std::cerr << "\n[ERROR_ENGINE] The currentVar_name that is causing exception is: ("
 							<< currentVar_name << ")\n";
@@ -284,13 +510,15 @@ public:
 				for (size_t index = 1; index < parameters.size(); index++)
 				{
 					str& currentVar_name = parameters[index];
-					if (!base_memory.m_containsVariable(currentVar_name))
+					if (!base_memory.m_containsVariable(currentVar_name) && !base_memory.m_containsList(currentVar_name) &&
+						!base_memory.m_containsDict(currentVar_name))
 					{
 						std::cerr << "\n[ERROR_ENGINE] The currentVar_name that is causing exception is: ("
 							<< currentVar_name << ")\n";
 						throw std::runtime_error("Can't find the variable!");
 					}
-					if (toMemory.m_containsVariable(currentVar_name))
+					if (toMemory.m_containsVariable(currentVar_name) || toMemory.m_containsList(currentVar_name) ||
+						toMemory.m_containsDict(currentVar_name))
 					{
 						std::cerr << "\n[ERROR_ENGINE] The currentVar_name that is causing exception is: ("
 							<< currentVar_name << ")\n";
@@ -318,7 +546,7 @@ public:
 							<< sectionName << ")\n";
 						throw std::runtime_error("Can't find the section in the memory! Use buildMemory() before execute()");
 					}
-					execute(sectionName);
+					pm_run(sectionName, memoryUnion[sectionName]);
 					continue;
 				}
 			}
@@ -365,14 +593,141 @@ public:
 				continue;
 			else {
 
-				if (!all_utilities.contains(currentIns.___TODO___)) {
+				// find() rather than operator[], which may insert: sections can run on several threads.
+				auto utility = all_utilities.find(currentIns.___TODO___);
+				if (utility == all_utilities.end()) {
 					std::cerr << "\n[ERROR_ENGINE] The ___TODO___ that is causing exception is: ("
 						<< currentIns.___TODO___ << ")\n";
 					throw std::runtime_error("The function is not provided by the utility!");
 				}
-				all_utilities[currentIns.___TODO___]
-				(currentIns.___PARAMETERS___, currentIns.___RETURN___ADDRESS___, base_memory);
+				utility->second(currentIns.___PARAMETERS___, currentIns.___RETURN___ADDRESS___, base_memory);
+			}
+		}
+	}
+
+	// @map : (xs, section) ~ ys, @filter : (xs, section) ~ ys and @reduce : (xs, section, init) ~ acc.
+	// Each call runs the section in a fresh frame holding the element as "item" (and, for reduce,
+	// the running value as "acc"); the section leaves its answer in "result". Sections that reach
+	// other sections' memory (@import, @export, @execute) are refused, since calls run concurrently;
+	// sections that do I/O are run sequentially so their output keeps the list's order.
+	void pm_applySection(const ___INSTRUCTION___T___& ins, SectionMemory& memory)
+	{
+		const str& operation = ins.___TODO___;
+		const std::vector<str>& parameters = ins.___PARAMETERS___;
+		const str& return_address = ins.___RETURN___ADDRESS___;
+		bool is_reduce = operation == "reduce";
+
+		if (parameters.size() != (is_reduce ? 3u : 2u) || return_address == "nullptr")
+			throw std::runtime_error(is_reduce ?
+				"@reduce requires a list, a section and an initial value! Syntax: @reduce : (xs, section, init) ~ acc;" :
+				"@" + operation + " requires a list and a section! Syntax: @" + operation + " : (xs, section) ~ ys;");
+
+		const str& section = parameters[1];
+		auto code = compiledCode.find(section);
+		if (code == compiledCode.end())
+		{
+			std::cerr << "\n[ERROR_ENGINE] The sectionName that is causing exception is: ("
+				<< section << ")\n";
+			throw std::runtime_error("Can't find the section!");
+		}
+
+		static const robin_hood::unordered_flat_set<str> input_output = {
+			"print", "println", "flush", "input", "read_lines", "read_all", "print_list", "print_dict",
+			"open", "read_line", "file_eof", "write", "writeln", "close", "foreach_line"
+		};
+		bool sequential = pm_inWorker;
+		for (const auto& instruction : code->second) {
+			const str& todo = instruction.___TODO___;
+			if (todo == "import" || todo == "export" || todo == "execute")
+				throw std::runtime_error("The section passed to @" + operation + " can't use @import, @export or @execute!");
+			if (input_output.contains(todo) || todo.rfind("print_fmt", 0) == 0)
+				sequential = true;
+		}
+
+		auto call = [this, &section, &operation](const value_t& item, const value_t* acc) {
+			SectionMemory frame;
+			frame.m_setOutput(&output_buffer);
+			frame.m_setInput(input_source.get());
+			frame.m_insertVariable("item", item);
+			if (acc)
+				frame.m_insertVariable("acc", *acc);
+			pm_run(section, frame);
+			if (!frame.m_containsVariable("result"))
+				throw std::runtime_error("The section passed to @" + operation + " must set the variable 'result'!");
+			return frame.m_getVariable("result");
+		};
+		// Splits [0, count) into chunks, on all cores unless the calls must stay sequential.
+		auto for_chunks = [sequential](size_t count, size_t grain, auto&& fn) {
+			struct WorkerScope {
+				bool outer = pm_inWorker;
+				WorkerScope() { pm_inWorker = true; }
+				~WorkerScope() { pm_inWorker = outer; }
+			};
+			if (sequential || count < 2) {
+				for (size_t begin = 0; begin < count; begin += grain)
+					fn(begin, std::min(count, begin + grain));
+				return;
+			}
+			Parallel::forChunks(count, grain, [&fn](size_t begin, size_t end) {
+				WorkerScope scope;
+				fn(begin, end);
+				});
+		};
+
+		// Snapshot: shares the storage, and stays intact if a section could ever modify the list.
+		const ListValue items = memory.m_getList(parameters[0]);
+		size_t count = items.m_size();
+		size_t grain = std::max<size_t>(1, count / (Parallel::workerCount() * 8));
+
+		if (operation == "map") {
+			std::vector<value_t> results(count);
+			for_chunks(count, grain, [&](size_t begin, size_t end) {
+				for (size_t idx = begin; idx < end; ++idx)
+					results[idx] = call(items.m_at(idx), nullptr);
+				});
+			ListEngine::storeList(memory, return_address, ListValue::m_fromValues(std::move(results)));
+		}
+		else if (operation == "filter") {
+			std::vector<char> keep(count);
+			for_chunks(count, grain, [&](size_t begin, size_t end) {
+				for (size_t idx = begin; idx < end; ++idx) {
+					value_t verdict = call(items.m_at(idx), nullptr);
+					if (verdict.second != ENUM_TYPE_BOOL)
+						throw std::runtime_error("The section passed to @filter must set 'result' to a bool!");
+					keep[idx] = std::get<bool>(verdict.first);
+				}
+				});
+			ListValue kept = items.m_visit([&keep](auto values) {
+				using T = typename decltype(values)::value_type;
+				std::vector<T> selected;
+				for (size_t idx = 0; idx < values.size(); ++idx)
+					if (keep[idx])
+						selected.push_back(values[idx]);
+				return ListValue(std::move(selected));
+				});
+			ListEngine::storeList(memory, return_address, std::move(kept));
+		}
+		else {
+			// Each chunk is folded on its own, starting from its first element, and the partial
+			// results are then folded into init in list order. This needs the section to be
+			// associative, but not commutative.
+			value_t accumulator = ListEngine::parseItem(parameters[2], memory, "reduce");
+			if (sequential) {
+				for (size_t idx = 0; idx < count; ++idx)
+					accumulator = call(items.m_at(idx), &accumulator);
+			}
+			else {
+				std::vector<value_t> partials((count + grain - 1) / grain);
+				for_chunks(count, grain, [&](size_t begin, size_t end) {
+					value_t partial = items.m_at(begin);
+					for (size_t idx = begin + 1; idx < end; ++idx)
+						partial = call(items.m_at(idx), &partial);
+					partials[begin / grain] = std::move(partial);
+					});
+				for (const auto& partial : partials)
+					accumulator = call(partial, &accumulator);
 			}
+			memory.m_reInsertVariable(return_address, accumulator);
 		}
 	}
 };
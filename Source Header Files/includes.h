@@ -17,5 +17,22 @@
 #include <iomanip>
 #include <sstream>
 #include <climits> 
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <charconv>
+#include <utility>
+#include <string_view>
+#include <span>
+#include <memory>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <bit>
+#include <cstring>
+#include <fstream>
 #include <functional>
 #include <chrono>
\ No newline at end of file